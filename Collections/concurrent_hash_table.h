@@ -0,0 +1,496 @@
+#ifndef INC_3DGAME_CONCURRENT_HASH_TABLE_H
+#define INC_3DGAME_CONCURRENT_HASH_TABLE_H
+
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <bit>
+#include <type_traits>
+#include "hash_table.h"
+
+namespace bice
+{
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename ARRAY_ALLOCATOR = std::allocator<HashNode<std::pair<KEY, VALUE>, true>*>,
+            typename LIST_ALLOCATOR = NodePoolAllocator<HashNode<std::pair<KEY, VALUE>, true>>,
+            typename BUCKET_POLICY = PowerOfTwoBucketPolicy
+    >
+    class ConcurrentHashTable
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using const_value_reference                    = const value_type&;
+        using size_type                                = std::uint64_t;
+        using difference_type                          = std::int64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using bucket_policy                            = BUCKET_POLICY;
+        using node_type                                = HashNode<value_type, true>;
+        using node_pointer                             = node_type*;
+        using array_allocator_type                     = typename std::allocator_traits<ARRAY_ALLOCATOR>::template rebind_alloc<node_pointer>;
+        using list_allocator_type                      = typename std::allocator_traits<LIST_ALLOCATOR>::template rebind_alloc<node_type>;
+        using shared_mutex_type                        = std::shared_mutex;
+        using shared_lock_type                         = std::shared_lock<std::shared_mutex>;
+        using unique_lock_type                         = std::unique_lock<std::shared_mutex>;
+
+        explicit ConcurrentHashTable(
+                const size_type stripeCount_ = 16,
+                const size_type count = BUCKET_POLICY::initial_capacity,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL()
+                ) :
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                maxLoadFactor(3.0f),
+                tableSize{},
+                stripeCount(std::bit_ceil(stripeCount_ > 0 ? stripeCount_ : 1)),
+                stripeShift(64 - (size_type)std::countr_zero(stripeCount)),
+                stripes(new stripe_type[stripeCount])
+                {
+                    const size_type stripeBuckets = BUCKET_POLICY::capacity_for(count > stripeCount ? count / stripeCount : 1);
+                    for(size_type idx = 0; idx < stripeCount; ++idx)
+                    {
+                        if (!rehash_stripe(stripes[idx], stripeBuckets))
+                        {
+                            for(size_type jdx = 0; jdx < idx; ++jdx)
+                            {
+                                free_stripe(stripes[jdx]);
+                            }
+                            throw std::bad_alloc();
+                        }
+                    }
+                }
+
+        ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+        ConcurrentHashTable& operator = (const ConcurrentHashTable&) = delete;
+        ConcurrentHashTable(ConcurrentHashTable&&) = delete;
+        ConcurrentHashTable& operator = (ConcurrentHashTable&&) = delete;
+
+        virtual ~ConcurrentHashTable()
+        {
+            for(size_type idx = 0; idx < stripeCount; ++idx)
+            {
+                free_stripe(stripes[idx]);
+            }
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return tableSize.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] inline size_type stripe_count() const noexcept
+        {
+            return stripeCount;
+        }
+
+        [[nodiscard]] size_type capacity() const
+        {
+            size_type totalCapacity{0};
+            for(size_type idx = 0; idx < stripeCount; ++idx)
+            {
+                shared_lock_type lock(stripes[idx].mutex);
+                totalCapacity += stripes[idx].arrayCapacity;
+            }
+            return totalCapacity;
+        }
+
+        [[nodiscard]] inline float load_factor() const
+        {
+            const size_type totalCapacity = capacity();
+            return totalCapacity == 0 ? 0.0f : (float)size() / (float)totalCapacity;
+        }
+
+        [[nodiscard]] inline float max_load_factor() const noexcept
+        {
+            return maxLoadFactor.load(std::memory_order_relaxed);
+        }
+
+        void max_load_factor(const float loadFactor) noexcept
+        {
+            if (loadFactor > 0.0f)
+            {
+                maxLoadFactor.store(loadFactor, std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] std::optional<mapped_type> find(const key_type& key) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const stripe_type& stripe = stripe_of(keyHash);
+            shared_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node != nullptr)
+            {
+                return node->data.second;
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const stripe_type& stripe = stripe_of(keyHash);
+            shared_lock_type lock(stripe.mutex);
+            return find_in_stripe(stripe, keyHash, key) != nullptr;
+        }
+
+        template<typename FUNCTION>
+        bool visit(const key_type& key, FUNCTION&& function) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const stripe_type& stripe = stripe_of(keyHash);
+            shared_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node != nullptr)
+            {
+                function(static_cast<const mapped_type&>(node->data.second));
+                return true;
+            }
+            return false;
+        }
+
+        template<typename FUNCTION>
+        bool update(const key_type& key, FUNCTION&& function)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            stripe_type& stripe = stripe_of(keyHash);
+            unique_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node != nullptr)
+            {
+                function(node->data.second);
+                return true;
+            }
+            return false;
+        }
+
+        bool insert(const key_type& key, const mapped_type& value)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            stripe_type& stripe = stripe_of(keyHash);
+            unique_lock_type lock(stripe.mutex);
+            if (find_in_stripe(stripe, keyHash, key) != nullptr)
+            {
+                return false;
+            }
+            return emplace_in_stripe(stripe, keyHash, key, value) != nullptr;
+        }
+
+        bool insert(const_value_reference value)
+        {
+            return insert(value.first, value.second);
+        }
+
+        template<typename MAPPED>
+        bool insert_or_assign(const key_type& key, MAPPED&& value)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            stripe_type& stripe = stripe_of(keyHash);
+            unique_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node != nullptr)
+            {
+                node->data.second = std::forward<MAPPED>(value);
+                return false;
+            }
+            return emplace_in_stripe(stripe, keyHash, key, std::forward<MAPPED>(value)) != nullptr;
+        }
+
+        template<typename FUNCTION>
+        mapped_type compute_if_absent(const key_type& key, FUNCTION&& function)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            stripe_type& stripe = stripe_of(keyHash);
+            {
+                shared_lock_type lock(stripe.mutex);
+                node_pointer node = find_in_stripe(stripe, keyHash, key);
+                if (node != nullptr)
+                {
+                    return node->data.second;
+                }
+            }
+
+            unique_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node == nullptr)
+            {
+                node = emplace_in_stripe(stripe, keyHash, key, function(key));
+                if (node == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            return node->data.second;
+        }
+
+        bool erase(const key_type& key)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            stripe_type& stripe = stripe_of(keyHash);
+            unique_lock_type lock(stripe.mutex);
+            node_pointer node = find_in_stripe(stripe, keyHash, key);
+            if (node == nullptr)
+            {
+                return false;
+            }
+
+            const size_type index = BUCKET_POLICY::index(keyHash, stripe.arrayCapacity);
+            if (node->previous == nullptr)
+            {
+                stripe.array[index] = node->next;
+            } else
+            {
+                node->previous->next = node->next;
+            }
+            if (node->next != nullptr)
+            {
+                node->next->previous = node->previous;
+            }
+
+            (*node).~node_type();
+            stripe.listAllocator.deallocate(node, 1);
+            --stripe.stripeSize;
+            tableSize.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        template<typename FUNCTION>
+        void for_each(FUNCTION&& function) const
+        {
+            for(size_type idx = 0; idx < stripeCount; ++idx)
+            {
+                shared_lock_type lock(stripes[idx].mutex);
+                for(size_type bucket = 0; bucket < stripes[idx].arrayCapacity; ++bucket)
+                {
+                    for(node_pointer node = stripes[idx].array[bucket]; node != nullptr; node = node->next)
+                    {
+                        function(static_cast<const value_type&>(node->data));
+                    }
+                }
+            }
+        }
+
+        void reserve(const size_type count)
+        {
+            const size_type stripeBuckets = BUCKET_POLICY::capacity_for(count > stripeCount ? count / stripeCount : 1);
+            for(size_type idx = 0; idx < stripeCount; ++idx)
+            {
+                unique_lock_type lock(stripes[idx].mutex);
+                if (stripeBuckets > stripes[idx].arrayCapacity)
+                {
+                    rehash_stripe(stripes[idx], stripeBuckets);
+                }
+            }
+        }
+
+        void clear()
+        {
+            for(size_type idx = 0; idx < stripeCount; ++idx)
+            {
+                unique_lock_type lock(stripes[idx].mutex);
+                const size_type removed = stripes[idx].stripeSize;
+                free_nodes(stripes[idx]);
+                for(size_type bucket = 0; bucket < stripes[idx].arrayCapacity; ++bucket)
+                {
+                    stripes[idx].array[bucket] = nullptr;
+                }
+                stripes[idx].stripeSize = 0;
+                tableSize.fetch_sub(removed, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+
+        struct alignas(64) stripe_type
+        {
+            mutable shared_mutex_type mutex;
+            array_allocator_type arrayAllocator;
+            list_allocator_type listAllocator;
+            node_pointer* array{nullptr};
+            size_type arrayCapacity{0};
+            size_type stripeSize{0};
+        };
+
+        hasher hashFun;
+        key_equal keyEqual;
+        std::atomic<float> maxLoadFactor;
+        std::atomic<size_type> tableSize;
+        size_type stripeCount;
+        size_type stripeShift;
+        std::unique_ptr<stripe_type[]> stripes;
+
+        [[nodiscard]] inline stripe_type& stripe_of(const size_type keyHash) const noexcept
+        {
+            if (stripeCount == 1)
+            {
+                return stripes[0];
+            }
+            return stripes[(keyHash * 0x9E3779B97F4A7C15ull) >> stripeShift];
+        }
+
+        [[nodiscard]] node_pointer find_in_stripe(const stripe_type& stripe, const size_type keyHash, const key_type& key) const
+        {
+            node_pointer node = stripe.array[BUCKET_POLICY::index(keyHash, stripe.arrayCapacity)];
+            while (node != nullptr)
+            {
+                if (node->hash == keyHash && keyEqual(node->data.first, key))
+                {
+                    return node;
+                }
+                node = node->next;
+            }
+            return nullptr;
+        }
+
+        template<typename MAPPED>
+        node_pointer emplace_in_stripe(stripe_type& stripe, const size_type keyHash, const key_type& key, MAPPED&& value)
+        {
+            if ((float)(stripe.stripeSize + 1) / (float)stripe.arrayCapacity > maxLoadFactor.load(std::memory_order_relaxed))
+            {
+                rehash_stripe(stripe, BUCKET_POLICY::capacity_for(stripe.arrayCapacity * 2));
+            }
+
+            node_pointer node{nullptr};
+            try
+            {
+                node = stripe.listAllocator.allocate(1);
+                new(node) node_type{value_type(key, std::forward<MAPPED>(value)), nullptr, nullptr, keyHash};
+            } catch (std::bad_alloc)
+            {
+                return nullptr;
+            } catch (...)
+            {
+                stripe.listAllocator.deallocate(node, 1);
+                throw;
+            }
+
+            const size_type index = BUCKET_POLICY::index(keyHash, stripe.arrayCapacity);
+            node->next = stripe.array[index];
+            if (node->next != nullptr)
+            {
+                node->next->previous = node;
+            }
+            stripe.array[index] = node;
+
+            ++stripe.stripeSize;
+            tableSize.fetch_add(1, std::memory_order_relaxed);
+            return node;
+        }
+
+        bool rehash_stripe(stripe_type& stripe, const size_type newCapacity)
+        {
+            node_pointer* workArray{nullptr};
+            try
+            {
+                workArray = stripe.arrayAllocator.allocate(newCapacity);
+            } catch (std::bad_alloc)
+            {
+                return false;
+            }
+
+            for(size_type idx = 0; idx < newCapacity; ++idx)
+            {
+                workArray[idx] = nullptr;
+            }
+
+            node_pointer node{nullptr};
+            node_pointer insertNode{nullptr};
+            for(size_type idx = 0; idx < stripe.arrayCapacity; ++idx)
+            {
+                node = stripe.array[idx];
+                while (node != nullptr)
+                {
+                    insertNode = node;
+                    node = node->next;
+
+                    const size_type index = BUCKET_POLICY::index(insertNode->hash, newCapacity);
+                    insertNode->previous = nullptr;
+                    insertNode->next = workArray[index];
+                    if (insertNode->next != nullptr)
+                    {
+                        insertNode->next->previous = insertNode;
+                    }
+                    workArray[index] = insertNode;
+                }
+            }
+
+            if (stripe.array != nullptr)
+            {
+                stripe.arrayAllocator.deallocate(stripe.array, stripe.arrayCapacity);
+            }
+            stripe.array = workArray;
+            stripe.arrayCapacity = newCapacity;
+            return true;
+        }
+
+        void free_nodes(stripe_type& stripe) noexcept
+        {
+            constexpr bool bulkRelease = requires(list_allocator_type& allocator_) { allocator_.release(); };
+            if (bulkRelease && std::is_trivially_destructible_v<node_type>)
+            {
+                if constexpr (bulkRelease)
+                {
+                    stripe.listAllocator.release();
+                }
+                return;
+            }
+
+            node_pointer node{nullptr};
+            node_pointer deleteNode{nullptr};
+            for(size_type idx = 0; idx < stripe.arrayCapacity; ++idx)
+            {
+                node = stripe.array[idx];
+                while (node != nullptr)
+                {
+                    deleteNode = node;
+                    node = node->next;
+                    (*deleteNode).~node_type();
+                    if constexpr (!bulkRelease)
+                    {
+                        stripe.listAllocator.deallocate(deleteNode, 1);
+                    }
+                }
+            }
+
+            if constexpr (bulkRelease)
+            {
+                stripe.listAllocator.release();
+            }
+        }
+
+        void free_stripe(stripe_type& stripe) noexcept
+        {
+            if (stripe.array != nullptr)
+            {
+                free_nodes(stripe);
+                stripe.arrayAllocator.deallocate(stripe.array, stripe.arrayCapacity);
+                stripe.array = nullptr;
+                stripe.arrayCapacity = 0;
+            }
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_CONCURRENT_HASH_TABLE_H
@@ -0,0 +1,895 @@
+#ifndef INC_3DGAME_FLAT_HASH_TABLE_H
+#define INC_3DGAME_FLAT_HASH_TABLE_H
+
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <bit>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BICE_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define BICE_FLAT_HASH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace bice
+{
+
+    class FlatHashGroup
+    {
+    public:
+
+        using control_type                             = std::int8_t;
+        using mask_type                                = std::uint32_t;
+
+        static constexpr std::uint64_t width           = 16;
+        static constexpr control_type empty            = -128;
+        static constexpr control_type deleted          = -2;
+
+        explicit FlatHashGroup(const control_type* control_) noexcept
+        {
+#if defined(BICE_FLAT_HASH_SSE2)
+            group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control_));
+#elif defined(BICE_FLAT_HASH_NEON)
+            group = vld1q_s8(control_);
+#else
+            std::memcpy(group, control_, width);
+#endif
+        }
+
+        [[nodiscard]] inline mask_type match(const control_type hash) const noexcept
+        {
+#if defined(BICE_FLAT_HASH_SSE2)
+            return (mask_type)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(hash)));
+#elif defined(BICE_FLAT_HASH_NEON)
+            return to_mask(vceqq_s8(group, vdupq_n_s8(hash)));
+#else
+            mask_type mask{0};
+            for(std::uint64_t idx = 0; idx < width; ++idx)
+            {
+                if (group[idx] == hash)
+                {
+                    mask |= mask_type(1) << idx;
+                }
+            }
+            return mask;
+#endif
+        }
+
+        [[nodiscard]] inline mask_type match_empty() const noexcept
+        {
+            return match(empty);
+        }
+
+        [[nodiscard]] inline mask_type match_empty_or_deleted() const noexcept
+        {
+#if defined(BICE_FLAT_HASH_SSE2)
+            return (mask_type)_mm_movemask_epi8(group);
+#elif defined(BICE_FLAT_HASH_NEON)
+            return to_mask(vcltq_s8(group, vdupq_n_s8(0)));
+#else
+            mask_type mask{0};
+            for(std::uint64_t idx = 0; idx < width; ++idx)
+            {
+                if (group[idx] < 0)
+                {
+                    mask |= mask_type(1) << idx;
+                }
+            }
+            return mask;
+#endif
+        }
+
+        [[nodiscard]] inline mask_type match_full() const noexcept
+        {
+            return ~match_empty_or_deleted() & 0xFFFFu;
+        }
+
+    private:
+
+#if defined(BICE_FLAT_HASH_SSE2)
+        __m128i group;
+#elif defined(BICE_FLAT_HASH_NEON)
+        int8x16_t group;
+
+        [[nodiscard]] static inline mask_type to_mask(const uint8x16_t lanes) noexcept
+        {
+            static const std::uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+            const uint8x16_t masked = vandq_u8(lanes, vld1q_u8(bits));
+            return (mask_type)vaddv_u8(vget_low_u8(masked)) | ((mask_type)vaddv_u8(vget_high_u8(masked)) << 8);
+        }
+#else
+        control_type group[width];
+#endif
+    };
+
+    template<typename FLAT_HASH_TABLE>
+    class FlatHashTableIterator
+    {
+    public:
+
+        using iterator_category                        = std::forward_iterator_tag;
+        using key_type                                 = typename FLAT_HASH_TABLE::key_type;
+        using mapped_type                              = typename FLAT_HASH_TABLE::mapped_type;
+        using value_type                               = typename FLAT_HASH_TABLE::value_type;
+        using size_type                                = typename FLAT_HASH_TABLE::size_type;
+        using difference_type                          = typename FLAT_HASH_TABLE::difference_type;
+        using reference                                = typename FLAT_HASH_TABLE::reference;
+        using pointer                                  = typename FLAT_HASH_TABLE::pointer;
+        using iterator                                 = FlatHashTableIterator<FLAT_HASH_TABLE>;
+        using hash_table_type                          = FLAT_HASH_TABLE;
+
+        FlatHashTableIterator() :
+        index{}, hashTable{}
+        {}
+
+        FlatHashTableIterator(const size_type& index_, hash_table_type* hashTable_) :
+        index(index_), hashTable(hashTable_)
+        {}
+
+        [[nodiscard]] inline reference operator * () const noexcept
+        {
+            return hashTable->get_slots()[index];
+        }
+
+        [[nodiscard]] inline pointer operator -> () const noexcept
+        {
+            return hashTable->get_slots() + index;
+        }
+
+        iterator& operator ++ () noexcept
+        {
+            index = hashTable->next_full(index + 1);
+            return *this;
+        }
+
+        iterator operator ++ (int) noexcept
+        {
+            iterator temp(*this);
+            index = hashTable->next_full(index + 1);
+            return temp;
+        }
+
+        [[nodiscard]] bool operator == (const iterator& other) const noexcept
+        {
+            return index == other.index && hashTable == other.hashTable;
+        }
+
+        [[nodiscard]] bool operator != (const iterator& other) const noexcept
+        {
+            return index != other.index || hashTable != other.hashTable;
+        }
+
+        [[nodiscard]] inline size_type get_index() const noexcept
+        {
+            return index;
+        }
+
+    private:
+
+        size_type index;
+        hash_table_type* hashTable;
+    };
+
+    template<typename FLAT_HASH_TABLE>
+    class ConstFlatHashTableIterator
+    {
+    public:
+
+        using iterator_category                        = std::forward_iterator_tag;
+        using key_type                                 = typename FLAT_HASH_TABLE::key_type;
+        using mapped_type                              = typename FLAT_HASH_TABLE::mapped_type;
+        using value_type                               = typename FLAT_HASH_TABLE::value_type;
+        using size_type                                = typename FLAT_HASH_TABLE::size_type;
+        using difference_type                          = typename FLAT_HASH_TABLE::difference_type;
+        using reference                                = typename FLAT_HASH_TABLE::const_reference;
+        using pointer                                  = typename FLAT_HASH_TABLE::const_pointer;
+        using iterator                                 = ConstFlatHashTableIterator<FLAT_HASH_TABLE>;
+        using hash_table_type                          = FLAT_HASH_TABLE;
+
+        ConstFlatHashTableIterator() :
+        index{}, hashTable{}
+        {}
+
+        ConstFlatHashTableIterator(const size_type& index_, const hash_table_type* hashTable_) :
+        index(index_), hashTable(hashTable_)
+        {}
+
+        [[nodiscard]] inline reference operator * () const noexcept
+        {
+            return hashTable->get_slots()[index];
+        }
+
+        [[nodiscard]] inline pointer operator -> () const noexcept
+        {
+            return hashTable->get_slots() + index;
+        }
+
+        iterator& operator ++ () noexcept
+        {
+            index = hashTable->next_full(index + 1);
+            return *this;
+        }
+
+        iterator operator ++ (int) noexcept
+        {
+            iterator temp(*this);
+            index = hashTable->next_full(index + 1);
+            return temp;
+        }
+
+        [[nodiscard]] bool operator == (const iterator& other) const noexcept
+        {
+            return index == other.index && hashTable == other.hashTable;
+        }
+
+        [[nodiscard]] bool operator != (const iterator& other) const noexcept
+        {
+            return index != other.index || hashTable != other.hashTable;
+        }
+
+        [[nodiscard]] inline size_type get_index() const noexcept
+        {
+            return index;
+        }
+
+    private:
+
+        size_type index;
+        const hash_table_type* hashTable;
+    };
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename SLOT_ALLOCATOR = std::allocator<std::pair<KEY, VALUE>>,
+            typename CONTROL_ALLOCATOR = std::allocator<std::int8_t>
+    >
+    class FlatHashTable
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using size_type                                = std::uint64_t;
+        using difference_type                          = std::int64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using slot_allocator_type                      = SLOT_ALLOCATOR;
+        using control_allocator_type                   = CONTROL_ALLOCATOR;
+        using reference                                = value_type&;
+        using const_reference                          = const value_type&;
+        using pointer                                  = value_type*;
+        using const_pointer                            = const value_type*;
+        using group_type                               = FlatHashGroup;
+        using control_type                             = FlatHashGroup::control_type;
+        using mask_type                                = FlatHashGroup::mask_type;
+        using iterator                                 = FlatHashTableIterator<FlatHashTable>;
+        using const_iterator                           = ConstFlatHashTableIterator<FlatHashTable>;
+
+        static constexpr size_type group_width         = FlatHashGroup::width;
+
+        explicit FlatHashTable(
+                const size_type count = 0,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                slot_allocator_type slotAllocator_ = SLOT_ALLOCATOR(),
+                control_allocator_type controlAllocator_ = CONTROL_ALLOCATOR()
+                ) :
+                slotAllocator(slotAllocator_),
+                controlAllocator(controlAllocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, tableCapacity{}, growthLeft{},
+                control{}, slots{}
+                {
+                    if (count > 0)
+                    {
+                        reserve(count);
+                    }
+                }
+
+        FlatHashTable(
+                std::initializer_list<value_type> list,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                slot_allocator_type slotAllocator_ = SLOT_ALLOCATOR(),
+                control_allocator_type controlAllocator_ = CONTROL_ALLOCATOR()
+                ) :
+                slotAllocator(slotAllocator_),
+                controlAllocator(controlAllocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, tableCapacity{}, growthLeft{},
+                control{}, slots{}
+                {
+                    reserve(list.size());
+                    for(auto iter = list.begin(); iter != list.end(); ++iter)
+                    {
+                        insert(*iter);
+                    }
+                }
+
+        template<typename ITERATOR>
+        FlatHashTable(
+                const ITERATOR begin, const ITERATOR end,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                slot_allocator_type slotAllocator_ = SLOT_ALLOCATOR(),
+                control_allocator_type controlAllocator_ = CONTROL_ALLOCATOR()
+                ) :
+                slotAllocator(slotAllocator_),
+                controlAllocator(controlAllocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, tableCapacity{}, growthLeft{},
+                control{}, slots{}
+                {
+                    difference_type distance{0};
+                    for(auto iter = begin; iter != end; ++iter)
+                    {
+                        ++distance;
+                    }
+
+                    reserve((size_type)distance);
+                    for(auto iter = begin; iter != end; ++iter)
+                    {
+                        insert(*iter);
+                    }
+                }
+
+        FlatHashTable(const FlatHashTable& other) :
+        slotAllocator(other.slotAllocator),
+        controlAllocator(other.controlAllocator),
+        hashFun(other.hashFun),
+        keyEqual(other.keyEqual),
+        tableSize{}, tableCapacity{}, growthLeft{},
+        control{}, slots{}
+        {
+            copy_from(other);
+        }
+
+        FlatHashTable& operator = (const FlatHashTable& other)
+        {
+            if (this != &other)
+            {
+                destroy();
+                hashFun = other.hashFun;
+                keyEqual = other.keyEqual;
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        FlatHashTable(FlatHashTable&& other) noexcept :
+        slotAllocator(std::move(other.slotAllocator)),
+        controlAllocator(std::move(other.controlAllocator)),
+        hashFun(std::move(other.hashFun)),
+        keyEqual(std::move(other.keyEqual)),
+        tableSize(other.tableSize),
+        tableCapacity(other.tableCapacity),
+        growthLeft(other.growthLeft),
+        control(other.control),
+        slots(other.slots)
+        {
+            other.tableSize = 0;
+            other.tableCapacity = 0;
+            other.growthLeft = 0;
+            other.control = nullptr;
+            other.slots = nullptr;
+        }
+
+        FlatHashTable& operator = (FlatHashTable&& other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                slotAllocator = std::move(other.slotAllocator);
+                controlAllocator = std::move(other.controlAllocator);
+                hashFun = std::move(other.hashFun);
+                keyEqual = std::move(other.keyEqual);
+                tableSize = other.tableSize;
+                tableCapacity = other.tableCapacity;
+                growthLeft = other.growthLeft;
+                control = other.control;
+                slots = other.slots;
+
+                other.tableSize = 0;
+                other.tableCapacity = 0;
+                other.growthLeft = 0;
+                other.control = nullptr;
+                other.slots = nullptr;
+            }
+            return *this;
+        }
+
+        virtual ~FlatHashTable()
+        {
+            destroy();
+        }
+
+        [[nodiscard]] inline iterator begin() noexcept
+        {
+            return iterator(next_full(0), this);
+        }
+
+        [[nodiscard]] inline const_iterator begin() const noexcept
+        {
+            return const_iterator(next_full(0), this);
+        }
+
+        [[nodiscard]] inline const_iterator cbegin() const noexcept
+        {
+            return const_iterator(next_full(0), this);
+        }
+
+        [[nodiscard]] inline iterator end() noexcept
+        {
+            return iterator(tableCapacity, this);
+        }
+
+        [[nodiscard]] inline const_iterator end() const noexcept
+        {
+            return const_iterator(tableCapacity, this);
+        }
+
+        [[nodiscard]] inline const_iterator cend() const noexcept
+        {
+            return const_iterator(tableCapacity, this);
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return tableSize;
+        }
+
+        [[nodiscard]] inline size_type capacity() const noexcept
+        {
+            return tableCapacity;
+        }
+
+        [[nodiscard]] inline size_type max_size() const noexcept
+        {
+            return std::numeric_limits<size_type>::max();
+        }
+
+        [[nodiscard]] inline float load_factor() const noexcept
+        {
+            return tableCapacity == 0 ? 0.0f : (float)tableSize / (float)tableCapacity;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return tableSize == 0;
+        }
+
+        [[nodiscard]] inline pointer get_slots() noexcept
+        {
+            return slots;
+        }
+
+        [[nodiscard]] inline const_pointer get_slots() const noexcept
+        {
+            return slots;
+        }
+
+        [[nodiscard]] size_type next_full(size_type index) const noexcept
+        {
+            while (index < tableCapacity)
+            {
+                const size_type groupBegin = index & ~(group_width - 1);
+                const mask_type mask = group_type(control + groupBegin).match_full() >> (index - groupBegin);
+                if (mask != 0)
+                {
+                    return index + (size_type)std::countr_zero(mask);
+                }
+                index = groupBegin + group_width;
+            }
+            return tableCapacity;
+        }
+
+        void reserve(const size_type& count)
+        {
+            const size_type newCapacity = capacity_for(count);
+            if (newCapacity > tableCapacity)
+            {
+                rehash_to(newCapacity);
+            }
+        }
+
+        std::pair<iterator, bool> insert(const_reference value)
+        {
+            return emplace_key(value.first, value);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            const key_type& key = value.first;
+            return emplace_key(key, std::move(value));
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            value_type value(std::forward<Args>(args)...);
+            const key_type& key = value.first;
+            return emplace_key(key, std::move(value));
+        }
+
+        [[nodiscard]] iterator find(const key_type& key)
+        {
+            return iterator(find_index(key), this);
+        }
+
+        [[nodiscard]] const_iterator find(const key_type& key) const
+        {
+            return const_iterator(find_index(key), this);
+        }
+
+        [[nodiscard]] iterator find(const_reference value)
+        {
+            const size_type index = find_index(value.first);
+            if (index < tableCapacity && slots[index].second == value.second)
+            {
+                return iterator(index, this);
+            }
+            return end();
+        }
+
+        [[nodiscard]] iterator find(const mapped_type& value) requires (!std::is_same_v<KEY, VALUE>)
+        {
+            for(size_type index = next_full(0); index < tableCapacity; index = next_full(index + 1))
+            {
+                if (slots[index].second == value)
+                {
+                    return iterator(index, this);
+                }
+            }
+            return end();
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return find_index(key) < tableCapacity;
+        }
+
+        void remove(const key_type& key)
+        {
+            const size_type index = find_index(key);
+            if (index < tableCapacity)
+            {
+                erase_index(index);
+            }
+        }
+
+        void remove(iterator removeIterator)
+        {
+            if (removeIterator.get_index() < tableCapacity)
+            {
+                erase_index(removeIterator.get_index());
+            }
+        }
+
+        void remove(const mapped_type& value) requires (!std::is_same_v<KEY, VALUE>)
+        {
+            iterator findIterator = find(value);
+            if (findIterator != end())
+            {
+                erase_index(findIterator.get_index());
+            }
+        }
+
+        void clear()
+        {
+            if (tableCapacity > 0)
+            {
+                for(size_type index = next_full(0); index < tableCapacity; index = next_full(index + 1))
+                {
+                    slots[index].~value_type();
+                }
+                std::memset(control, group_type::empty, tableCapacity);
+                tableSize = 0;
+                growthLeft = max_load(tableCapacity);
+            }
+        }
+
+        [[nodiscard]] bool operator == (const FlatHashTable& other) const
+        {
+            if (tableSize != other.tableSize)
+            {
+                return false;
+            }
+            for(size_type index = next_full(0); index < tableCapacity; index = next_full(index + 1))
+            {
+                const size_type otherIndex = other.find_index(slots[index].first);
+                if (otherIndex == other.tableCapacity || !(other.slots[otherIndex].second == slots[index].second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool operator != (const FlatHashTable& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        slot_allocator_type slotAllocator;
+        control_allocator_type controlAllocator;
+        hasher hashFun;
+        key_equal keyEqual;
+        size_type tableSize;
+        size_type tableCapacity;
+        size_type growthLeft;
+        control_type* control;
+        pointer slots;
+
+        [[nodiscard]] static inline size_type max_load(const size_type count) noexcept
+        {
+            return count - count / 8;
+        }
+
+        [[nodiscard]] static size_type capacity_for(const size_type count) noexcept
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+            size_type newCapacity = group_width;
+            while (max_load(newCapacity) < count)
+            {
+                newCapacity *= 2;
+            }
+            return newCapacity;
+        }
+
+        [[nodiscard]] inline size_type hash_of(const key_type& key) const
+        {
+            auto hashValue = (size_type)hashFun(key) * 0x9E3779B97F4A7C15ull;
+            return hashValue ^ (hashValue >> 32);
+        }
+
+        [[nodiscard]] static inline control_type control_of(const size_type hashValue) noexcept
+        {
+            return (control_type)(hashValue & 0x7F);
+        }
+
+        [[nodiscard]] size_type find_index(const key_type& key) const
+        {
+            if (tableSize == 0)
+            {
+                return tableCapacity;
+            }
+
+            const size_type hashValue = hash_of(key);
+            const control_type hashControl = control_of(hashValue);
+            const size_type groupMask = tableCapacity / group_width - 1;
+            size_type groupIndex = (hashValue >> 7) & groupMask;
+            size_type step{0};
+
+            while (true)
+            {
+                const group_type group(control + groupIndex * group_width);
+                mask_type mask = group.match(hashControl);
+                while (mask != 0)
+                {
+                    const size_type index = groupIndex * group_width + (size_type)std::countr_zero(mask);
+                    if (keyEqual(slots[index].first, key))
+                    {
+                        return index;
+                    }
+                    mask &= mask - 1;
+                }
+
+                if (group.match_empty() != 0)
+                {
+                    return tableCapacity;
+                }
+
+                ++step;
+                groupIndex = (groupIndex + step) & groupMask;
+            }
+        }
+
+        [[nodiscard]] size_type find_insert_index(const size_type hashValue) const noexcept
+        {
+            const size_type groupMask = tableCapacity / group_width - 1;
+            size_type groupIndex = (hashValue >> 7) & groupMask;
+            size_type step{0};
+
+            while (true)
+            {
+                const mask_type mask = group_type(control + groupIndex * group_width).match_empty_or_deleted();
+                if (mask != 0)
+                {
+                    return groupIndex * group_width + (size_type)std::countr_zero(mask);
+                }
+
+                ++step;
+                groupIndex = (groupIndex + step) & groupMask;
+            }
+        }
+
+        template<typename ARG>
+        std::pair<iterator, bool> emplace_key(const key_type& key, ARG&& value)
+        {
+            const size_type foundIndex = find_index(key);
+            if (foundIndex < tableCapacity)
+            {
+                return {iterator(foundIndex, this), false};
+            }
+
+            if (growthLeft == 0)
+            {
+                const size_type oldCapacity = tableCapacity;
+                if (tableCapacity > 0 && tableSize < max_load(tableCapacity) / 2)
+                {
+                    rehash_to(tableCapacity);
+                } else
+                {
+                    rehash_to(tableCapacity == 0 ? group_width : tableCapacity * 2);
+                }
+
+                if (tableCapacity == oldCapacity && growthLeft == 0)
+                {
+                    return {end(), false};
+                }
+            }
+
+            const size_type hashValue = hash_of(key);
+            const size_type index = find_insert_index(hashValue);
+            try
+            {
+                new(slots + index) value_type(std::forward<ARG>(value));
+            } catch (...)
+            {
+                return {end(), false};
+            }
+
+            if (control[index] == group_type::empty)
+            {
+                --growthLeft;
+            }
+            control[index] = control_of(hashValue);
+            ++tableSize;
+
+            return {iterator(index, this), true};
+        }
+
+        void erase_index(const size_type index)
+        {
+            slots[index].~value_type();
+            --tableSize;
+
+            const size_type groupBegin = index & ~(group_width - 1);
+            if (group_type(control + groupBegin).match_empty() != 0)
+            {
+                control[index] = group_type::empty;
+                ++growthLeft;
+            } else
+            {
+                control[index] = group_type::deleted;
+            }
+        }
+
+        void rehash_to(const size_type newCapacity)
+        {
+            control_type* workControl{nullptr};
+            pointer workSlots{nullptr};
+            try
+            {
+                workControl = controlAllocator.allocate(newCapacity);
+            } catch (std::bad_alloc)
+            {
+                return;
+            }
+
+            try
+            {
+                workSlots = slotAllocator.allocate(newCapacity);
+            } catch (std::bad_alloc)
+            {
+                controlAllocator.deallocate(workControl, newCapacity);
+                return;
+            }
+
+            std::memset(workControl, group_type::empty, newCapacity);
+
+            control_type* oldControl = control;
+            pointer oldSlots = slots;
+            const size_type oldCapacity = tableCapacity;
+
+            control = workControl;
+            slots = workSlots;
+            tableCapacity = newCapacity;
+
+            for(size_type idx = 0; idx < oldCapacity; ++idx)
+            {
+                if (oldControl[idx] >= 0)
+                {
+                    const size_type hashValue = hash_of(oldSlots[idx].first);
+                    const size_type index = find_insert_index(hashValue);
+                    new(slots + index) value_type(std::move(oldSlots[idx]));
+                    control[index] = control_of(hashValue);
+                    oldSlots[idx].~value_type();
+                }
+            }
+
+            growthLeft = max_load(tableCapacity) - tableSize;
+
+            if (oldCapacity > 0)
+            {
+                controlAllocator.deallocate(oldControl, oldCapacity);
+                slotAllocator.deallocate(oldSlots, oldCapacity);
+            }
+        }
+
+        void copy_from(const FlatHashTable& other)
+        {
+            if (other.tableSize == 0)
+            {
+                return;
+            }
+
+            rehash_to(other.tableCapacity);
+            if (tableCapacity != other.tableCapacity)
+            {
+                return;
+            }
+
+            for(size_type index = other.next_full(0); index < other.tableCapacity; index = other.next_full(index + 1))
+            {
+                try
+                {
+                    new(slots + index) value_type(other.slots[index]);
+                } catch (...)
+                {
+                    clear();
+                    return;
+                }
+                control[index] = other.control[index];
+                ++tableSize;
+            }
+
+            std::memcpy(control, other.control, tableCapacity);
+            growthLeft = other.growthLeft;
+        }
+
+        void destroy() noexcept
+        {
+            if (tableCapacity > 0)
+            {
+                for(size_type index = next_full(0); index < tableCapacity; index = next_full(index + 1))
+                {
+                    slots[index].~value_type();
+                }
+                controlAllocator.deallocate(control, tableCapacity);
+                slotAllocator.deallocate(slots, tableCapacity);
+            }
+            tableSize = 0;
+            tableCapacity = 0;
+            growthLeft = 0;
+            control = nullptr;
+            slots = nullptr;
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_FLAT_HASH_TABLE_H
@@ -0,0 +1,589 @@
+#ifndef INC_3DGAME_FROZEN_HASH_TABLE_H
+#define INC_3DGAME_FROZEN_HASH_TABLE_H
+
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+#include <type_traits>
+
+namespace bice
+{
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename ALLOCATOR = std::allocator<std::pair<KEY, VALUE>>
+    >
+    class FrozenHashTable
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using size_type                                = std::uint64_t;
+        using difference_type                          = std::int64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using seed_type                                = std::int64_t;
+        using key_allocator_type                       = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<KEY>;
+        using mapped_allocator_type                    = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<VALUE>;
+        using seed_allocator_type                      = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<seed_type>;
+
+        static constexpr size_type keys_per_bucket     = 4;
+        static constexpr size_type max_seed            = size_type{1} << 24;
+
+        template<typename K>
+        static constexpr bool is_transparent_key       = requires { typename HASH::is_transparent; typename KEY_EQUAL::is_transparent; }
+                                                         && std::is_invocable_v<const HASH&, const K&>
+                                                         && std::is_invocable_r_v<bool, const KEY_EQUAL&, const KEY&, const K&>;
+
+        FrozenHashTable(
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                ALLOCATOR allocator_ = ALLOCATOR()
+                ) :
+                keyAllocator(allocator_),
+                mappedAllocator(allocator_),
+                seedAllocator(allocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, slotCount{}, bucketCount{},
+                seeds{}, keys{}, values{}
+                {}
+
+        template<typename ITERATOR>
+        FrozenHashTable(
+                const ITERATOR begin, const ITERATOR end,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                ALLOCATOR allocator_ = ALLOCATOR()
+        ) :
+        keyAllocator(allocator_),
+        mappedAllocator(allocator_),
+        seedAllocator(allocator_),
+        hashFun(hasher_),
+        keyEqual(keyEqual_),
+        tableSize{}, slotCount{}, bucketCount{},
+        seeds{}, keys{}, values{}
+        {
+            build(begin, end);
+        }
+
+        FrozenHashTable(const FrozenHashTable& other) :
+        keyAllocator(other.keyAllocator),
+        mappedAllocator(other.mappedAllocator),
+        seedAllocator(other.seedAllocator),
+        hashFun(other.hashFun),
+        keyEqual(other.keyEqual),
+        tableSize{}, slotCount{}, bucketCount{},
+        seeds{}, keys{}, values{}
+        {
+            copy_from(other);
+        }
+
+        FrozenHashTable& operator = (const FrozenHashTable& other)
+        {
+            if (this != &other)
+            {
+                free_arrays();
+                hashFun = other.hashFun;
+                keyEqual = other.keyEqual;
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        FrozenHashTable(FrozenHashTable&& other) noexcept :
+        keyAllocator(std::move(other.keyAllocator)),
+        mappedAllocator(std::move(other.mappedAllocator)),
+        seedAllocator(std::move(other.seedAllocator)),
+        hashFun(std::move(other.hashFun)),
+        keyEqual(std::move(other.keyEqual)),
+        tableSize(other.tableSize), slotCount(other.slotCount), bucketCount(other.bucketCount),
+        seeds(other.seeds), keys(other.keys), values(other.values)
+        {
+            other.tableSize = 0;
+            other.slotCount = 0;
+            other.bucketCount = 0;
+            other.seeds = nullptr;
+            other.keys = nullptr;
+            other.values = nullptr;
+        }
+
+        FrozenHashTable& operator = (FrozenHashTable&& other) noexcept
+        {
+            if (this != &other)
+            {
+                free_arrays();
+                keyAllocator = std::move(other.keyAllocator);
+                mappedAllocator = std::move(other.mappedAllocator);
+                seedAllocator = std::move(other.seedAllocator);
+                hashFun = std::move(other.hashFun);
+                keyEqual = std::move(other.keyEqual);
+                tableSize = other.tableSize;
+                slotCount = other.slotCount;
+                bucketCount = other.bucketCount;
+                seeds = other.seeds;
+                keys = other.keys;
+                values = other.values;
+
+                other.tableSize = 0;
+                other.slotCount = 0;
+                other.bucketCount = 0;
+                other.seeds = nullptr;
+                other.keys = nullptr;
+                other.values = nullptr;
+            }
+            return *this;
+        }
+
+        virtual ~FrozenHashTable()
+        {
+            free_arrays();
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return tableSize;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return tableSize == 0;
+        }
+
+        [[nodiscard]] inline size_type bucket_count() const noexcept
+        {
+            return bucketCount;
+        }
+
+        [[nodiscard]] inline std::span<const key_type> key_span() const noexcept
+        {
+            return std::span<const key_type>(keys, tableSize);
+        }
+
+        [[nodiscard]] inline std::span<const mapped_type> value_span() const noexcept
+        {
+            return std::span<const mapped_type>(values, tableSize);
+        }
+
+        [[nodiscard]] const mapped_type* find(const key_type& key) const
+        {
+            return find_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        [[nodiscard]] const mapped_type* find(const K& key) const
+        {
+            return find_key(key);
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return find_key(key) != nullptr;
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return find_key(key) != nullptr;
+        }
+
+        [[nodiscard]] const mapped_type& at(const key_type& key) const
+        {
+            const mapped_type* value = find_key(key);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("Key not found");
+            }
+            return *value;
+        }
+
+    private:
+
+        key_allocator_type keyAllocator;
+        mapped_allocator_type mappedAllocator;
+        seed_allocator_type seedAllocator;
+        hasher hashFun;
+        key_equal keyEqual;
+        size_type tableSize;
+        size_type slotCount;
+        size_type bucketCount;
+        seed_type* seeds;
+        key_type* keys;
+        mapped_type* values;
+
+        [[nodiscard]] static inline size_type mix(size_type hashValue) noexcept
+        {
+            hashValue ^= hashValue >> 33;
+            hashValue *= 0xFF51AFD7ED558CCDull;
+            hashValue ^= hashValue >> 33;
+            hashValue *= 0xC4CEB9FE1A85EC53ull;
+            hashValue ^= hashValue >> 33;
+            return hashValue;
+        }
+
+        [[nodiscard]] inline size_type bucket_of(const size_type hashValue) const noexcept
+        {
+            return mix(hashValue) % bucketCount;
+        }
+
+        [[nodiscard]] inline size_type slot_of(const size_type hashValue, const seed_type seed) const noexcept
+        {
+            return mix(hashValue + (size_type)seed * 0x9E3779B97F4A7C15ull) % slotCount;
+        }
+
+        [[nodiscard]] inline size_type slot_for(const size_type hashValue) const noexcept
+        {
+            const seed_type seed = seeds[bucket_of(hashValue)];
+            return seed < 0 ? (size_type)(-seed - 1) : slot_of(hashValue, seed);
+        }
+
+        template<typename K>
+        [[nodiscard]] const mapped_type* find_key(const K& key) const
+        {
+            if (tableSize == 0)
+            {
+                return nullptr;
+            }
+
+            const size_type slot = slot_for((size_type)hashFun(key));
+            if (keyEqual(keys[slot], key))
+            {
+                return values + slot;
+            }
+            for(size_type idx = slotCount; idx < tableSize; ++idx)
+            {
+                if (keyEqual(keys[idx], key))
+                {
+                    return values + idx;
+                }
+            }
+            return nullptr;
+        }
+
+        template<typename ITERATOR>
+        void build(const ITERATOR begin, const ITERATOR end)
+        {
+            std::vector<ITERATOR> sources;
+            std::vector<size_type> hashes;
+            for(auto iter = begin; iter != end; ++iter)
+            {
+                sources.push_back(iter);
+                hashes.push_back((size_type)hashFun((*iter).first));
+            }
+            if (sources.empty())
+            {
+                return;
+            }
+
+            std::vector<size_type> byHash(sources.size());
+            for(size_type idx = 0; idx < byHash.size(); ++idx)
+            {
+                byHash[idx] = idx;
+            }
+            std::stable_sort(byHash.begin(), byHash.end(), [&](const size_type left, const size_type right)
+            {
+                return hashes[left] < hashes[right];
+            });
+
+            std::vector<size_type> primary;
+            std::vector<size_type> overflow;
+            for(size_type first = 0, last = 0; first < byHash.size(); first = last)
+            {
+                while (last < byHash.size() && hashes[byHash[last]] == hashes[byHash[first]])
+                {
+                    ++last;
+                }
+                primary.push_back(byHash[first]);
+                const auto kept = (size_type)overflow.size();
+                for(size_type idx = first + 1; idx < last; ++idx)
+                {
+                    const auto& key = (*sources[byHash[idx]]).first;
+                    bool duplicate = keyEqual((*sources[byHash[first]]).first, key);
+                    for(size_type jdx = kept; jdx < overflow.size() && !duplicate; ++jdx)
+                    {
+                        duplicate = keyEqual((*sources[overflow[jdx]]).first, key);
+                    }
+                    if (!duplicate)
+                    {
+                        overflow.push_back(byHash[idx]);
+                    }
+                }
+            }
+            std::sort(primary.begin(), primary.end());
+
+            const auto count = (size_type)primary.size();
+            const size_type total = count + (size_type)overflow.size();
+            {
+                std::vector<ITERATOR> keptSources;
+                std::vector<size_type> keptHashes;
+                for(const size_type idx : primary)
+                {
+                    keptSources.push_back(sources[idx]);
+                    keptHashes.push_back(hashes[idx]);
+                }
+                for(const size_type idx : overflow)
+                {
+                    keptSources.push_back(sources[idx]);
+                }
+                sources.swap(keptSources);
+                hashes.swap(keptHashes);
+            }
+
+            tableSize = total;
+            slotCount = count;
+            bucketCount = (count + keys_per_bucket - 1) / keys_per_bucket;
+
+            std::vector<size_type> bucketStart(bucketCount + 1, 0);
+            std::vector<size_type> members(count);
+            for(size_type idx = 0; idx < count; ++idx)
+            {
+                ++bucketStart[bucket_of(hashes[idx]) + 1];
+            }
+            for(size_type idx = 0; idx < bucketCount; ++idx)
+            {
+                bucketStart[idx + 1] += bucketStart[idx];
+            }
+            {
+                std::vector<size_type> fill(bucketStart.begin(), bucketStart.end() - 1);
+                for(size_type idx = 0; idx < count; ++idx)
+                {
+                    members[fill[bucket_of(hashes[idx])]++] = idx;
+                }
+            }
+
+            std::vector<size_type> order(bucketCount);
+            for(size_type idx = 0; idx < bucketCount; ++idx)
+            {
+                order[idx] = idx;
+            }
+            std::stable_sort(order.begin(), order.end(), [&](const size_type left, const size_type right)
+            {
+                return bucketStart[left + 1] - bucketStart[left] > bucketStart[right + 1] - bucketStart[right];
+            });
+
+            try
+            {
+                seeds = seedAllocator.allocate(bucketCount);
+            } catch (std::bad_alloc)
+            {
+                tableSize = 0;
+                slotCount = 0;
+                bucketCount = 0;
+                return;
+            }
+
+            std::vector<size_type> slots(total);
+            std::vector<bool> occupied(count, false);
+            std::vector<size_type> candidate;
+            size_type freeSlot{0};
+
+            for(const size_type bucket : order)
+            {
+                const size_type first = bucketStart[bucket];
+                const size_type last = bucketStart[bucket + 1];
+                if (last - first == 0)
+                {
+                    seeds[bucket] = 0;
+                } else if (last - first == 1)
+                {
+                    while (occupied[freeSlot])
+                    {
+                        ++freeSlot;
+                    }
+                    occupied[freeSlot] = true;
+                    slots[members[first]] = freeSlot;
+                    seeds[bucket] = -(seed_type)freeSlot - 1;
+                } else
+                {
+                    seed_type seed{0};
+                    for(; (size_type)seed < max_seed; ++seed)
+                    {
+                        candidate.clear();
+                        bool placed = true;
+                        for(size_type idx = first; idx < last && placed; ++idx)
+                        {
+                            const size_type slot = slot_of(hashes[members[idx]], seed);
+                            placed = !occupied[slot] && std::find(candidate.begin(), candidate.end(), slot) == candidate.end();
+                            candidate.push_back(slot);
+                        }
+                        if (placed)
+                        {
+                            break;
+                        }
+                    }
+
+                    if ((size_type)seed == max_seed)
+                    {
+                        seedAllocator.deallocate(seeds, bucketCount);
+                        seeds = nullptr;
+                        tableSize = 0;
+                        slotCount = 0;
+                        bucketCount = 0;
+                        throw std::invalid_argument("Perfect hash seed search failed");
+                    }
+
+                    seeds[bucket] = seed;
+                    for(size_type idx = first; idx < last; ++idx)
+                    {
+                        slots[members[idx]] = candidate[idx - first];
+                        occupied[candidate[idx - first]] = true;
+                    }
+                }
+            }
+
+            for(size_type idx = count; idx < total; ++idx)
+            {
+                slots[idx] = idx;
+            }
+
+            try
+            {
+                keys = keyAllocator.allocate(total);
+                values = mappedAllocator.allocate(total);
+            } catch (std::bad_alloc)
+            {
+                free_arrays();
+                return;
+            }
+
+            size_type constructed{0};
+            try
+            {
+                for(; constructed < total; ++constructed)
+                {
+                    const size_type slot = slots[constructed];
+                    const auto& source = *sources[constructed];
+                    new(keys + slot) key_type(source.first);
+                    try
+                    {
+                        new(values + slot) mapped_type(source.second);
+                    } catch (...)
+                    {
+                        keys[slot].~key_type();
+                        throw;
+                    }
+                }
+            } catch (...)
+            {
+                for(size_type idx = 0; idx < constructed; ++idx)
+                {
+                    keys[slots[idx]].~key_type();
+                    values[slots[idx]].~mapped_type();
+                }
+                keyAllocator.deallocate(keys, total);
+                mappedAllocator.deallocate(values, total);
+                keys = nullptr;
+                values = nullptr;
+                free_arrays();
+            }
+        }
+
+        void copy_from(const FrozenHashTable& other)
+        {
+            if (other.tableSize == 0)
+            {
+                return;
+            }
+
+            try
+            {
+                seeds = seedAllocator.allocate(other.bucketCount);
+                keys = keyAllocator.allocate(other.tableSize);
+                values = mappedAllocator.allocate(other.tableSize);
+            } catch (std::bad_alloc)
+            {
+                tableSize = other.tableSize;
+                bucketCount = other.bucketCount;
+                free_arrays();
+                return;
+            }
+
+            std::copy(other.seeds, other.seeds + other.bucketCount, seeds);
+            slotCount = other.slotCount;
+            bucketCount = other.bucketCount;
+
+            size_type constructed{0};
+            try
+            {
+                for(; constructed < other.tableSize; ++constructed)
+                {
+                    new(keys + constructed) key_type(other.keys[constructed]);
+                    try
+                    {
+                        new(values + constructed) mapped_type(other.values[constructed]);
+                    } catch (...)
+                    {
+                        keys[constructed].~key_type();
+                        throw;
+                    }
+                }
+            } catch (...)
+            {
+                tableSize = constructed;
+                free_values(other.tableSize);
+                tableSize = other.tableSize;
+                free_arrays();
+                return;
+            }
+
+            tableSize = other.tableSize;
+        }
+
+        void free_values(const size_type capacity) noexcept
+        {
+            for(size_type idx = 0; idx < tableSize; ++idx)
+            {
+                keys[idx].~key_type();
+                values[idx].~mapped_type();
+            }
+            keyAllocator.deallocate(keys, capacity);
+            mappedAllocator.deallocate(values, capacity);
+            keys = nullptr;
+            values = nullptr;
+        }
+
+        void free_arrays() noexcept
+        {
+            if (keys != nullptr && values != nullptr)
+            {
+                free_values(tableSize);
+            } else
+            {
+                if (keys != nullptr)
+                {
+                    keyAllocator.deallocate(keys, tableSize);
+                }
+                if (values != nullptr)
+                {
+                    mappedAllocator.deallocate(values, tableSize);
+                }
+                keys = nullptr;
+                values = nullptr;
+            }
+
+            if (seeds != nullptr)
+            {
+                seedAllocator.deallocate(seeds, bucketCount);
+            }
+            seeds = nullptr;
+            tableSize = 0;
+            slotCount = 0;
+            bucketCount = 0;
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_FROZEN_HASH_TABLE_H
@@ -0,0 +1,210 @@
+#ifndef INC_3DGAME_HASH_FUNCTIONS_H
+#define INC_3DGAME_HASH_FUNCTIONS_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#define BICE_HASH_UMUL128
+#include <intrin.h>
+#endif
+
+namespace bice
+{
+
+    class IntegerHash
+    {
+    public:
+
+        using is_transparent                           = void;
+        using size_type                                = std::uint64_t;
+
+        IntegerHash() noexcept : seed{} {}
+
+        explicit IntegerHash(const size_type seed_) noexcept : seed(seed_) {}
+
+        template<typename KEY> requires std::is_integral_v<KEY> || std::is_enum_v<KEY>
+        [[nodiscard]] inline size_type operator () (const KEY key) const noexcept
+        {
+            return mix((size_type)key ^ seed);
+        }
+
+        template<typename KEY>
+        [[nodiscard]] inline size_type operator () (const KEY* key) const noexcept
+        {
+            return mix((size_type)reinterpret_cast<std::uintptr_t>(key) ^ seed);
+        }
+
+        [[nodiscard]] static inline constexpr size_type mix(size_type value) noexcept
+        {
+            value ^= value >> 32;
+            value *= 0xd6e8feb86659fd93ull;
+            value ^= value >> 32;
+            value *= 0xd6e8feb86659fd93ull;
+            value ^= value >> 32;
+            return value;
+        }
+
+    private:
+
+        size_type seed;
+    };
+
+    class StringHash
+    {
+    public:
+
+        using is_transparent                           = void;
+        using size_type                                = std::uint64_t;
+
+        StringHash() noexcept : seed{} {}
+
+        explicit StringHash(const size_type seed_) noexcept : seed(seed_) {}
+
+        [[nodiscard]] inline size_type operator () (const std::string_view key) const noexcept
+        {
+            return hash_bytes(key.data(), key.size(), seed);
+        }
+
+        [[nodiscard]] inline size_type operator () (const std::string& key) const noexcept
+        {
+            return hash_bytes(key.data(), key.size(), seed);
+        }
+
+        [[nodiscard]] inline size_type operator () (const char* key) const noexcept
+        {
+            return hash_bytes(key, std::strlen(key), seed);
+        }
+
+        [[nodiscard]] static size_type hash_bytes(const void* data, const size_type length, size_type seed_) noexcept
+        {
+            auto bytes = static_cast<const unsigned char*>(data);
+            size_type first{0};
+            size_type second{0};
+            seed_ ^= mix(seed_ ^ secret0, secret1);
+
+            if (length <= 16)
+            {
+                if (length >= 4)
+                {
+                    const size_type shift = (length >> 3) << 2;
+                    first = (read4(bytes) << 32) | read4(bytes + shift);
+                    second = (read4(bytes + length - 4) << 32) | read4(bytes + length - 4 - shift);
+                } else if (length > 0)
+                {
+                    first = ((size_type)bytes[0] << 16) | ((size_type)bytes[length >> 1] << 8) | (size_type)bytes[length - 1];
+                }
+            } else
+            {
+                size_type remaining = length;
+                if (remaining > 48)
+                {
+                    size_type seed1 = seed_;
+                    size_type seed2 = seed_;
+                    do
+                    {
+                        seed_ = mix(read8(bytes) ^ secret1, read8(bytes + 8) ^ seed_);
+                        seed1 = mix(read8(bytes + 16) ^ secret2, read8(bytes + 24) ^ seed1);
+                        seed2 = mix(read8(bytes + 32) ^ secret3, read8(bytes + 40) ^ seed2);
+                        bytes += 48;
+                        remaining -= 48;
+                    } while (remaining > 48);
+                    seed_ ^= seed1 ^ seed2;
+                }
+
+                while (remaining > 16)
+                {
+                    seed_ = mix(read8(bytes) ^ secret1, read8(bytes + 8) ^ seed_);
+                    bytes += 16;
+                    remaining -= 16;
+                }
+
+                first = read8(bytes + remaining - 16);
+                second = read8(bytes + remaining - 8);
+            }
+
+            first ^= secret1;
+            second ^= seed_;
+            multiply(first, second);
+            return mix(first ^ secret0 ^ length, second ^ secret1);
+        }
+
+    private:
+
+        static constexpr size_type secret0             = 0x2d358dccaa6c78a5ull;
+        static constexpr size_type secret1             = 0x8bb84b93962eacc9ull;
+        static constexpr size_type secret2             = 0x4b33a62ed433d4a3ull;
+        static constexpr size_type secret3             = 0x4d5a2da51de1aa47ull;
+
+        size_type seed;
+
+        [[nodiscard]] static inline size_type read8(const unsigned char* bytes) noexcept
+        {
+            std::uint64_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        [[nodiscard]] static inline size_type read4(const unsigned char* bytes) noexcept
+        {
+            std::uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        static inline void multiply(size_type& low, size_type& high) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 uint128_type;
+            const uint128_type product = (uint128_type)low * high;
+            low = (size_type)product;
+            high = (size_type)(product >> 64);
+#elif defined(BICE_HASH_UMUL128)
+            low = _umul128(low, high, &high);
+#else
+            const size_type lowLow = (low & 0xffffffffull) * (high & 0xffffffffull);
+            const size_type highLow = (low >> 32) * (high & 0xffffffffull);
+            const size_type lowHigh = (low & 0xffffffffull) * (high >> 32);
+            const size_type highHigh = (low >> 32) * (high >> 32);
+            const size_type middle = (lowLow >> 32) + (highLow & 0xffffffffull) + lowHigh;
+            low = (middle << 32) | (lowLow & 0xffffffffull);
+            high = highHigh + (highLow >> 32) + (middle >> 32);
+#endif
+        }
+
+        [[nodiscard]] static inline size_type mix(size_type low, size_type high) noexcept
+        {
+            multiply(low, high);
+            return low ^ high;
+        }
+    };
+
+    template<typename KEY>
+    struct Hash : std::hash<KEY> {};
+
+    template<typename KEY> requires std::is_integral_v<KEY> || std::is_enum_v<KEY> || std::is_pointer_v<KEY>
+    struct Hash<KEY> : IntegerHash
+    {
+        using IntegerHash::IntegerHash;
+    };
+
+    template<>
+    struct Hash<std::string> : StringHash
+    {
+        using StringHash::StringHash;
+    };
+
+    template<>
+    struct Hash<std::string_view> : StringHash
+    {
+        using StringHash::StringHash;
+    };
+
+}
+
+#endif //INC_3DGAME_HASH_FUNCTIONS_H
@@ -10,11 +10,41 @@
 #include <utility>
 #include <algorithm>
 #include <functional>
+#include <tuple>
+#include <limits>
+#include <type_traits>
+#include <bit>
+#include <span>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "node_pool_allocator.h"
+#include "frozen_hash_table.h"
+
+#if defined(BICE_HASH_TABLE_STATS)
+#include <chrono>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 namespace bice
 {
 
-    template<typename TYPE>
+    inline void prefetch_address(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    template<typename TYPE, bool CACHE_HASH = false>
     struct HashNode
     {
         using value_type                               = TYPE;
@@ -22,22 +52,61 @@ namespace bice
         using const_reference                          = const TYPE&;
         using pointer                                  = TYPE*;
         using const_pointer                            = const TYPE*;
-        using node_pointer                             = HashNode<TYPE>*;
-        using const_node_pointer                       = const HashNode<TYPE>*;
+        using node_pointer                             = HashNode<TYPE, CACHE_HASH>*;
+        using const_node_pointer                       = const HashNode<TYPE, CACHE_HASH>*;
+
+        static constexpr bool cached_hash              = false;
+
+        [[nodiscard]] inline bool operator == (const HashNode& other) const noexcept
+        {
+            return data == other.data && previous == other.previous && next == other.next;
+        }
+
+        [[nodiscard]] inline bool operator != (const HashNode& other) const noexcept
+        {
+            return data != other.data || previous != other.previous || next != other.next;
+        }
+
+        inline void set_hash(const std::uint64_t) noexcept
+        {}
+
+        value_type data;
+        node_pointer previous;
+        node_pointer next;
+    };
+
+    template<typename TYPE>
+    struct HashNode<TYPE, true>
+    {
+        using value_type                               = TYPE;
+        using reference                                = TYPE&;
+        using const_reference                          = const TYPE&;
+        using pointer                                  = TYPE*;
+        using const_pointer                            = const TYPE*;
+        using node_pointer                             = HashNode<TYPE, true>*;
+        using const_node_pointer                       = const HashNode<TYPE, true>*;
 
-        [[nodiscard]] inline bool operator == (const HashNode<value_type>& other) const noexcept
+        static constexpr bool cached_hash              = true;
+
+        [[nodiscard]] inline bool operator == (const HashNode& other) const noexcept
         {
             return data == other.data && previous == other.previous && next == other.next;
         }
 
-        [[nodiscard]] inline bool operator != (const HashNode<value_type>& other) const noexcept
+        [[nodiscard]] inline bool operator != (const HashNode& other) const noexcept
         {
             return data != other.data || previous != other.previous || next != other.next;
         }
 
+        inline void set_hash(const std::uint64_t hash_) noexcept
+        {
+            hash = hash_;
+        }
+
         value_type data;
         node_pointer previous;
         node_pointer next;
+        std::uint64_t hash;
     };
 
     template<typename HASH_TABLE>
@@ -54,8 +123,8 @@ namespace bice
         using reference                                = typename HASH_TABLE::reference;
         using pointer                                  = typename HASH_TABLE::pointer;
         using iterator                                 = HashTableIterator<HASH_TABLE>;
-        using node_type                                = HashNode<value_type>;
-        using node_pointer                             = HashNode<value_type>*;
+        using node_type                                = typename HASH_TABLE::node_type;
+        using node_pointer                             = typename HASH_TABLE::node_pointer;
         using hash_table_type                          = HASH_TABLE;
 
         key_type first;
@@ -152,20 +221,10 @@ namespace bice
                     nextNode = node->next;
                 } else
                 {
-                    size_type nextIndex = index + 1;
-                    node_pointer* hashArray = hashTable->get_array();
-                    while (nextIndex < arrayCapacity)
-                    {
-                        if (hashArray[nextIndex] != nullptr)
-                        {
-                            nextNode = hashArray[nextIndex];
-                            break;
-                        }
-                        ++nextIndex;
-                    }
-                    if (nextNode == nullptr)
+                    const size_type nextIndex = hashTable->next_occupied(index + 1);
+                    if (nextIndex < arrayCapacity)
                     {
-                        nextIndex = arrayCapacity;
+                        nextNode = hashTable->get_array()[nextIndex];
                     }
                     index = nextIndex;
                 }
@@ -199,8 +258,8 @@ namespace bice
         using reference                                = typename HASH_TABLE::const_reference;
         using pointer                                  = typename HASH_TABLE::const_pointer;
         using iterator                                 = ConstHashTableIterator<HASH_TABLE>;
-        using node_type                                = HashNode<value_type>;
-        using node_pointer                             = HashNode<value_type>*;
+        using node_type                                = typename HASH_TABLE::node_type;
+        using node_pointer                             = typename HASH_TABLE::node_pointer;
         using hash_table_type                          = HASH_TABLE;
 
         key_type first;
@@ -288,8 +347,7 @@ namespace bice
 
         void get_next()
         {
-            const size_type arrayCapacity = hashTable->capacity();
-            if (index <= arrayCapacity)
+            if (index <= hashTable->end_slot())
             {
                 node_pointer nextNode{nullptr};
                 if (node->next != nullptr)
@@ -297,22 +355,8 @@ namespace bice
                     nextNode = node->next;
                 } else
                 {
-                    size_type nextIndex = index + 1;
-                    node_pointer* hashArray = hashTable->get_array();
-                    while (nextIndex < arrayCapacity)
-                    {
-                        if (hashArray[nextIndex] != nullptr)
-                        {
-                            nextNode = hashArray[nextIndex];
-                            break;
-                        }
-                        ++nextIndex;
-                    }
-                    if (nextNode == nullptr)
-                    {
-                        nextIndex = arrayCapacity;
-                    }
-                    index = nextIndex;
+                    index = hashTable->next_slot(index + 1);
+                    nextNode = hashTable->slot_node(index);
                 }
 
                 node = nextNode;
@@ -329,243 +373,490 @@ namespace bice
         }
     };
 
-    template<
-            typename KEY,
-            typename VALUE,
-            typename HASH = std::hash<KEY>,
-            typename KEY_EQUAL = std::equal_to<KEY>,
-            typename ARRAY_ALLOCATOR = std::allocator<HashNode<std::pair<KEY, VALUE>>*>,
-            typename LIST_ALLOCATOR = std::allocator<HashNode<std::pair<KEY, VALUE>>>
-    >
-    class HashTable
+    template<typename HASH_TABLE>
+    class HashTableViewIterator
     {
     public:
 
-        using key_type                                 = KEY;
-        using mapped_type                              = VALUE;
-        using value_type                               = std::pair<KEY, VALUE>;
-        using size_type                                = std::uint64_t;
-        using difference_type                          = std::int64_t;
-        using hasher                                   = HASH;
-        using key_equal                                = KEY_EQUAL;
-        using array_allocator_type                     = ARRAY_ALLOCATOR;
-        using list_allocator_type                      = LIST_ALLOCATOR;
-        using reference                                = value_type&;
-        using const_reference                          = const value_type&;
-        using pointer                                  = value_type*;
-        using const_pointer                            = const value_type*;
-        using node_type                                = HashNode<value_type>;
-        using node_pointer                             = node_type*;
-        using array_type                               = node_type**;
-        using const_array_type                         = const array_type;
-        using iterator                                 = HashTableIterator<HashTable<KEY, VALUE, HASH, KEY_EQUAL, ARRAY_ALLOCATOR, LIST_ALLOCATOR>>;
-        using const_iterator                           = ConstHashTableIterator<HashTable<KEY, VALUE, HASH, KEY_EQUAL, ARRAY_ALLOCATOR, LIST_ALLOCATOR>>;
+        using iterator_category                        = std::forward_iterator_tag;
+        using key_type                                 = typename HASH_TABLE::key_type;
+        using mapped_type                              = typename HASH_TABLE::mapped_type;
+        using value_type                               = typename HASH_TABLE::value_type;
+        using size_type                                = typename HASH_TABLE::size_type;
+        using difference_type                          = typename HASH_TABLE::difference_type;
+        using reference                                = typename HASH_TABLE::reference;
+        using pointer                                  = typename HASH_TABLE::pointer;
+        using iterator                                 = HashTableViewIterator<HASH_TABLE>;
+        using node_type                                = typename HASH_TABLE::node_type;
+        using node_pointer                             = typename HASH_TABLE::node_pointer;
+        using hash_table_type                          = HASH_TABLE;
 
-        HashTable(
-                const size_type count = 11,
-                hasher hasher_ = HASH(),
-                key_equal keyEqual_ = KEY_EQUAL(),
-                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
-                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
-                ) :
-                arrayAllocator(arrayAllocator_),
-                listAllocator(listAllocator_),
-                hashFun(hasher_),
-                keyEqual(keyEqual_),
-                tableSize{}, arrayCapacity{}, array{}
-                {
-                    node_pointer* workArray{nullptr};
-                    node_pointer* workIterator{nullptr};
-                    try
-                    {
-                        workArray = arrayAllocator.allocate(count);
-                    } catch (std::bad_alloc)
-                    {
-                        return;
-                    }
+        HashTableViewIterator() noexcept :
+        index{},
+        hashTable{}, node{}
+        {}
 
-                    workIterator = workArray;
-                    for(size_type idx = 0; idx < count; ++idx)
-                    {
-                        *workIterator = nullptr;
-                        ++workIterator;
-                    }
+        HashTableViewIterator(
+                const size_type& index_,
+                hash_table_type* hashTable_,
+                node_pointer node_
+        ) noexcept :
+                index(index_),
+                hashTable(hashTable_),
+                node(node_)
+        {}
 
-                    arrayCapacity = count;
-                    array = workArray;
-                }
+        [[nodiscard]] inline reference operator * () const noexcept
+        {
+            return node->data;
+        }
 
-        HashTable(
-                std::initializer_list<value_type> list,
-                hasher hasher_ = HASH(),
-                key_equal keyEqual_ = KEY_EQUAL(),
-                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
-                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
-                ) :
-                arrayAllocator(arrayAllocator_),
-                listAllocator(listAllocator_),
-                hashFun(hasher_),
-                keyEqual(keyEqual_),
-                tableSize{}, arrayCapacity{}, array{}
-                {
-                    if (list.size() > 0)
-                    {
-                        for(auto iter = list.begin(); iter != list.end(); ++iter)
-                        {
-                            insert(*iter);
-                        }
+        [[nodiscard]] inline pointer operator -> () const noexcept
+        {
+            return &(node->data);
+        }
 
-                        if (tableSize < list.size())
-                        {
-                            clear();
-                        }
-                    }
-                }
+        [[nodiscard]] inline const key_type& key() const noexcept
+        {
+            return node->data.first;
+        }
 
-        template<typename ITERATOR>
-        HashTable(
-                const ITERATOR begin, const ITERATOR end,
-                hasher hasher_ = HASH(),
-                key_equal keyEqual_ = KEY_EQUAL(),
-                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
-                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
-        )
+        [[nodiscard]] inline mapped_type& value() const noexcept
         {
-            difference_type distance{0};
-            for(auto iter = begin; iter != end; ++iter)
-            {
-                ++distance;
-            }
+            return node->data.second;
+        }
 
-            if (distance > 0)
-            {
-                for(auto iter = begin; iter != end; ++iter)
-                {
-                    insert(*iter);
-                }
-                if (tableSize < distance)
-                {
-                    clear();
-                }
-            }
+        iterator& operator ++ () noexcept
+        {
+            get_next();
+            return *this;
         }
 
-        HashTable(const HashTable& other)
+        iterator operator ++ (int) noexcept
         {
-            arrayAllocator = other.arrayAllocator;
-            listAllocator = other.listAllocator;
-            hashFun = other.hashFun;
-            keyEqual = other.keyEqual;
-            tableSize = other.tableSize;
-            arrayCapacity = other.arrayCapacity;
-            array = nullptr;
-            if (tableSize > 0)
-            {
-                node_pointer* workArray{nullptr};
-                node_pointer* workIterator{nullptr};
-                try
-                {
-                    workArray = arrayAllocator.allocate(arrayCapacity);
-                } catch (std::bad_alloc)
-                {
-                    arrayCapacity = 0;
-                    tableSize = 0;
-                    return;
-                }
+            iterator temp(*this);
+            get_next();
+            return temp;
+        }
 
-                workIterator = workArray;
+        [[nodiscard]] bool operator == (const iterator& other) const noexcept
+        {
+            return index == other.index && hashTable == other.hashTable && node == other.node;
+        }
 
-                for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                {
-                    *workIterator = nullptr;
-                    ++workIterator;
-                }
+        [[nodiscard]] bool operator != (const iterator& other) const noexcept
+        {
+            return index != other.index || hashTable != other.hashTable || node != other.node;
+        }
 
-                array = workArray;
+        [[nodiscard]] inline size_type get_index() const noexcept
+        {
+            return index;
+        }
 
-                node_pointer otherArrayNode{nullptr};
-                node_pointer arrayNode{nullptr};
-                node_pointer workNode{nullptr};
+        [[nodiscard]] inline node_pointer get_node() const noexcept
+        {
+            return node;
+        }
 
-                for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                {
-                    otherArrayNode = other.array[idx];
-                    arrayNode = array[idx];
-                    while (otherArrayNode != nullptr)
-                    {
-                        try
-                        {
-                            workNode = listAllocator.allocate(1);
-                            new(workNode) node_type{value_type(otherArrayNode->data), nullptr, nullptr};
-                        } catch (std::bad_alloc)
-                        {
-                            clear();
-                            return;
-                        } catch (...)
-                        {
-                            (*workNode).~node_type();
-                            listAllocator.deallocate(workNode, 1);
-                            clear();
-                            return;
-                        }
+    private:
 
-                        if(array[idx] == nullptr)
-                        {
-                            array[idx] = workNode;
-                            arrayNode = workNode;
-                        } else
-                        {
-                            arrayNode->next = workNode;
-                            workNode->previous = arrayNode;
-                            arrayNode = workNode;
-                        }
+        size_type index;
+        hash_table_type* hashTable;
+        node_pointer node;
 
-                        otherArrayNode = otherArrayNode->next;
-                    }
-                }
+        void get_next() noexcept
+        {
+            if (node->next != nullptr)
+            {
+                node = node->next;
+                return;
             }
+
+            index = hashTable->next_occupied(index + 1);
+            node = index < hashTable->capacity() ? hashTable->get_array()[index] : nullptr;
         }
+    };
 
-        HashTable& operator = (const HashTable& other)
+    template<typename HASH_TABLE>
+    class ConstHashTableViewIterator
+    {
+    public:
+
+        using iterator_category                        = std::forward_iterator_tag;
+        using key_type                                 = typename HASH_TABLE::key_type;
+        using mapped_type                              = typename HASH_TABLE::mapped_type;
+        using value_type                               = typename HASH_TABLE::value_type;
+        using size_type                                = typename HASH_TABLE::size_type;
+        using difference_type                          = typename HASH_TABLE::difference_type;
+        using reference                                = typename HASH_TABLE::const_reference;
+        using pointer                                  = typename HASH_TABLE::const_pointer;
+        using iterator                                 = ConstHashTableViewIterator<HASH_TABLE>;
+        using node_type                                = typename HASH_TABLE::node_type;
+        using node_pointer                             = typename HASH_TABLE::node_pointer;
+        using hash_table_type                          = HASH_TABLE;
+
+        ConstHashTableViewIterator() noexcept :
+        index{},
+        hashTable{}, node{}
+        {}
+
+        ConstHashTableViewIterator(
+                const size_type& index_,
+                const hash_table_type* hashTable_,
+                node_pointer node_
+        ) noexcept :
+                index(index_),
+                hashTable(hashTable_),
+                node(node_)
+        {}
+
+        [[nodiscard]] inline reference operator * () const noexcept
         {
-            if (arrayCapacity > 0 && array != nullptr)
+            return node->data;
+        }
+
+        [[nodiscard]] inline pointer operator -> () const noexcept
+        {
+            return &(node->data);
+        }
+
+        [[nodiscard]] inline const key_type& key() const noexcept
+        {
+            return node->data.first;
+        }
+
+        [[nodiscard]] inline const mapped_type& value() const noexcept
+        {
+            return node->data.second;
+        }
+
+        iterator& operator ++ () noexcept
+        {
+            get_next();
+            return *this;
+        }
+
+        iterator operator ++ (int) noexcept
+        {
+            iterator temp(*this);
+            get_next();
+            return temp;
+        }
+
+        [[nodiscard]] bool operator == (const iterator& other) const noexcept
+        {
+            return index == other.index && hashTable == other.hashTable && node == other.node;
+        }
+
+        [[nodiscard]] bool operator != (const iterator& other) const noexcept
+        {
+            return index != other.index || hashTable != other.hashTable || node != other.node;
+        }
+
+        [[nodiscard]] inline size_type get_index() const noexcept
+        {
+            return index;
+        }
+
+        [[nodiscard]] inline node_pointer get_node() const noexcept
+        {
+            return node;
+        }
+
+    private:
+
+        size_type index;
+        const hash_table_type* hashTable;
+        node_pointer node;
+
+        void get_next() noexcept
+        {
+            if (node->next != nullptr)
             {
-                if (tableSize > 0)
+                node = node->next;
+                return;
+            }
+
+            index = hashTable->next_slot(index + 1);
+            node = hashTable->slot_node(index);
+        }
+    };
+
+    template<typename ITERATOR>
+    class HashTableView
+    {
+    public:
+
+        using iterator                                 = ITERATOR;
+
+        HashTableView(const iterator first_, const iterator last_) noexcept :
+        first(first_), last(last_)
+        {}
+
+        [[nodiscard]] inline iterator begin() const noexcept
+        {
+            return first;
+        }
+
+        [[nodiscard]] inline iterator end() const noexcept
+        {
+            return last;
+        }
+
+    private:
+
+        iterator first;
+        iterator last;
+    };
+
+    struct HashTableStats
+    {
+        static constexpr std::uint64_t histogram_size  = 16;
+
+        std::uint64_t size{};
+        std::uint64_t capacity{};
+        float loadFactor{};
+        std::uint64_t chainLengthHistogram[histogram_size]{};
+        std::uint64_t maxChainLength{};
+        std::uint64_t lookupCount{};
+        std::uint64_t probeCount{};
+        std::uint64_t maxProbes{};
+        std::uint64_t rehashCount{};
+        std::uint64_t rehashNanoseconds{};
+        std::uint64_t nodeAllocations{};
+        std::uint64_t nodeDeallocations{};
+        std::uint64_t bucketArrayAllocations{};
+        std::uint64_t bloomRejections{};
+
+        [[nodiscard]] inline double average_probes() const noexcept
+        {
+            return lookupCount == 0 ? 0.0 : (double)probeCount / (double)lookupCount;
+        }
+    };
+
+    struct ModuloBucketPolicy
+    {
+        using size_type                                = std::uint64_t;
+
+        static constexpr size_type initial_capacity    = 11;
+
+        [[nodiscard]] static inline size_type capacity_for(const size_type count) noexcept
+        {
+            return count;
+        }
+
+        [[nodiscard]] static inline size_type index(const size_type hashValue, const size_type capacity) noexcept
+        {
+            return hashValue % capacity;
+        }
+    };
+
+    struct PowerOfTwoBucketPolicy
+    {
+        using size_type                                = std::uint64_t;
+
+        static constexpr size_type initial_capacity    = 16;
+
+        [[nodiscard]] static inline size_type capacity_for(const size_type count) noexcept
+        {
+            return std::bit_ceil(count);
+        }
+
+        [[nodiscard]] static inline size_type index(const size_type hashValue, const size_type capacity) noexcept
+        {
+            const size_type mixed = hashValue * 0x9E3779B97F4A7C15ull;
+            return (mixed ^ (mixed >> 32)) & (capacity - 1);
+        }
+    };
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename ARRAY_ALLOCATOR = std::allocator<HashNode<std::pair<KEY, VALUE>>*>,
+            typename LIST_ALLOCATOR = NodePoolAllocator<HashNode<std::pair<KEY, VALUE>>>,
+            typename BUCKET_POLICY = PowerOfTwoBucketPolicy,
+            bool CACHE_HASH = false
+    >
+    class HashTable
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using size_type                                = std::uint64_t;
+        using difference_type                          = std::int64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using node_type                                = HashNode<std::pair<KEY, VALUE>, CACHE_HASH>;
+        using node_pointer                             = node_type*;
+        using array_allocator_type                     = typename std::allocator_traits<ARRAY_ALLOCATOR>::template rebind_alloc<node_pointer>;
+        using list_allocator_type                      = typename std::allocator_traits<LIST_ALLOCATOR>::template rebind_alloc<node_type>;
+        using bucket_policy                            = BUCKET_POLICY;
+        using reference                                = value_type&;
+        using const_reference                          = const value_type&;
+        using pointer                                  = value_type*;
+        using const_pointer                            = const value_type*;
+        using array_type                               = node_type**;
+        using const_array_type                         = const array_type;
+        using iterator                                 = HashTableIterator<HashTable>;
+        using const_iterator                           = ConstHashTableIterator<HashTable>;
+        using view_iterator                            = HashTableViewIterator<HashTable>;
+        using const_view_iterator                      = ConstHashTableViewIterator<HashTable>;
+        using view_type                                = HashTableView<view_iterator>;
+        using const_view_type                          = HashTableView<const_view_iterator>;
+        using frozen_type                              = FrozenHashTable<KEY, VALUE, HASH, KEY_EQUAL>;
+
+        template<typename K>
+        static constexpr bool is_transparent_key       = requires { typename HASH::is_transparent; typename KEY_EQUAL::is_transparent; }
+                                                         && std::is_invocable_v<const HASH&, const K&>
+                                                         && std::is_invocable_r_v<bool, const KEY_EQUAL&, const KEY&, const K&>;
+
+        HashTable(
+                const size_type count_ = BUCKET_POLICY::initial_capacity,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
+                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
+                ) :
+                arrayAllocator(arrayAllocator_),
+                listAllocator(listAllocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, arrayCapacity{}, array{},
+                oldCapacity{}, oldArray{}, migrateIndex{}, rehashStep{},
+                occupancy{}, occupancyWords{},
+                maxLoadFactor(3.0f), shrinkLoadFactor{},
+                bloomFilter{}, bloomBlocks{}, bloomBitsPerKey{}, bloomRemoved{},
+                bloomPending{}, bloomPendingBlocks{}
                 {
-                    node_pointer arrayNode{nullptr};
-                    node_pointer deleteNode{nullptr};
+                    const size_type count = BUCKET_POLICY::capacity_for(count_ > 0 ? count_ : 1);
+                    node_pointer* workArray{nullptr};
+                    node_pointer* workIterator{nullptr};
+                    try
+                    {
+                        workArray = allocate_buckets(count);
+                    } catch (std::bad_alloc)
+                    {
+                        return;
+                    }
 
-                    for(size_type idx = 0; idx < arrayCapacity; ++idx)
+                    if (!allocate_occupancy(count))
                     {
-                        arrayNode = array[idx];
-                        deleteNode = arrayNode;
-                        while (arrayNode != nullptr)
-                        {
-                            arrayNode = arrayNode->next;
-                            (*deleteNode).~node_type();
-                            listAllocator.deallocate(deleteNode, 1);
-                            deleteNode = arrayNode;
-                        }
+                        arrayAllocator.deallocate(workArray, count);
+                        return;
                     }
+
+                    workIterator = workArray;
+                    for(size_type idx = 0; idx < count; ++idx)
+                    {
+                        *workIterator = nullptr;
+                        ++workIterator;
+                    }
+
+                    arrayCapacity = count;
+                    array = workArray;
                 }
-                arrayAllocator.deallocate(array, arrayCapacity);
+
+        HashTable(
+                std::initializer_list<value_type> list,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
+                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
+                ) :
+                arrayAllocator(arrayAllocator_),
+                listAllocator(listAllocator_),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                tableSize{}, arrayCapacity{}, array{},
+                oldCapacity{}, oldArray{}, migrateIndex{}, rehashStep{},
+                occupancy{}, occupancyWords{},
+                maxLoadFactor(3.0f), shrinkLoadFactor{},
+                bloomFilter{}, bloomBlocks{}, bloomBitsPerKey{}, bloomRemoved{},
+                bloomPending{}, bloomPendingBlocks{}
+                {
+                    if (list.size() > 0)
+                    {
+                        bulk_build(list.begin(), list.end(), (size_type)list.size());
+                    }
+                }
+
+        template<typename ITERATOR>
+        HashTable(
+                const ITERATOR begin, const ITERATOR end,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                array_allocator_type arrayAllocator_ = ARRAY_ALLOCATOR(),
+                list_allocator_type listAllocator_ = LIST_ALLOCATOR()
+        ) :
+        arrayAllocator(arrayAllocator_),
+        listAllocator(listAllocator_),
+        hashFun(hasher_),
+        keyEqual(keyEqual_),
+        tableSize{}, arrayCapacity{}, array{},
+        oldCapacity{}, oldArray{}, migrateIndex{}, rehashStep{},
+        occupancy{}, occupancyWords{},
+        maxLoadFactor(3.0f), shrinkLoadFactor{},
+        bloomFilter{}, bloomBlocks{}, bloomBitsPerKey{}, bloomRemoved{},
+        bloomPending{}, bloomPendingBlocks{}
+        {
+            const difference_type distance = std::distance(begin, end);
+            if (distance > 0)
+            {
+                bulk_build(begin, end, (size_type)distance);
             }
+        }
 
-            array = nullptr;
-            arrayCapacity = other.arrayCapacity;
+        HashTable(const HashTable& other)
+        {
+            arrayAllocator = other.arrayAllocator;
+            listAllocator = other.listAllocator;
+            hashFun = other.hashFun;
+            keyEqual = other.keyEqual;
             tableSize = other.tableSize;
-            if (tableSize > 0)
+            arrayCapacity = other.arrayCapacity;
+            array = nullptr;
+            oldCapacity = 0;
+            oldArray = nullptr;
+            migrateIndex = 0;
+            rehashStep = other.rehashStep;
+            maxLoadFactor = other.maxLoadFactor;
+            shrinkLoadFactor = other.shrinkLoadFactor;
+            occupancy = nullptr;
+            occupancyWords = 0;
+            bloomFilter = nullptr;
+            bloomBlocks = 0;
+            bloomBitsPerKey = other.bloomBitsPerKey;
+            bloomRemoved = 0;
+            bloomPending = nullptr;
+            bloomPendingBlocks = 0;
+            if (tableSize == 0)
+            {
+                arrayCapacity = 0;
+            } else
             {
                 node_pointer* workArray{nullptr};
                 node_pointer* workIterator{nullptr};
                 try
                 {
-                    workArray = arrayAllocator.allocate(arrayCapacity);
+                    workArray = allocate_buckets(arrayCapacity);
                 } catch (std::bad_alloc)
                 {
                     arrayCapacity = 0;
                     tableSize = 0;
-                    return *this;
+                    return;
+                }
+
+                if (!allocate_occupancy(arrayCapacity))
+                {
+                    arrayAllocator.deallocate(workArray, arrayCapacity);
+                    arrayCapacity = 0;
+                    tableSize = 0;
+                    return;
                 }
 
                 workIterator = workArray;
@@ -581,6 +872,7 @@ namespace bice
                 node_pointer otherArrayNode{nullptr};
                 node_pointer arrayNode{nullptr};
                 node_pointer workNode{nullptr};
+
                 for(size_type idx = 0; idx < arrayCapacity; ++idx)
                 {
                     otherArrayNode = other.array[idx];
@@ -589,328 +881,1698 @@ namespace bice
                     {
                         try
                         {
-                            workNode = listAllocator.allocate(1);
+                            workNode = allocate_node();
                             new(workNode) node_type{value_type(otherArrayNode->data), nullptr, nullptr};
+                            workNode->set_hash(node_hash(otherArrayNode));
                         } catch (std::bad_alloc)
                         {
-                            clear();
-                            return *this;
-                        } catch (...)
+                            clear();
+                            return;
+                        } catch (...)
+                        {
+                            (*workNode).~node_type();
+                            deallocate_node(workNode);
+                            clear();
+                            return;
+                        }
+
+                        if(array[idx] == nullptr)
+                        {
+                            array[idx] = workNode;
+                            mark_occupied(idx);
+                            arrayNode = workNode;
+                        } else
+                        {
+                            arrayNode->next = workNode;
+                            workNode->previous = arrayNode;
+                            arrayNode = workNode;
+                        }
+
+                        otherArrayNode = otherArrayNode->next;
+                    }
+                }
+
+                if (!copy_pending_nodes(other))
+                {
+                    clear();
+                    return;
+                }
+            }
+            rebuild_bloom();
+        }
+
+        HashTable& operator = (const HashTable& other)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if (arrayCapacity > 0 && array != nullptr)
+            {
+                free_nodes();
+                arrayAllocator.deallocate(array, arrayCapacity);
+            }
+            free_old_array();
+            free_occupancy();
+            free_bloom();
+
+            array = nullptr;
+            arrayCapacity = other.arrayCapacity;
+            tableSize = other.tableSize;
+            maxLoadFactor = other.maxLoadFactor;
+            shrinkLoadFactor = other.shrinkLoadFactor;
+            bloomBitsPerKey = other.bloomBitsPerKey;
+            if (tableSize == 0)
+            {
+                arrayCapacity = 0;
+            } else
+            {
+                node_pointer* workArray{nullptr};
+                node_pointer* workIterator{nullptr};
+                try
+                {
+                    workArray = allocate_buckets(arrayCapacity);
+                } catch (std::bad_alloc)
+                {
+                    arrayCapacity = 0;
+                    tableSize = 0;
+                    return *this;
+                }
+
+                if (!allocate_occupancy(arrayCapacity))
+                {
+                    arrayAllocator.deallocate(workArray, arrayCapacity);
+                    arrayCapacity = 0;
+                    tableSize = 0;
+                    return *this;
+                }
+
+                workIterator = workArray;
+
+                for(size_type idx = 0; idx < arrayCapacity; ++idx)
+                {
+                    *workIterator = nullptr;
+                    ++workIterator;
+                }
+
+                array = workArray;
+
+                node_pointer otherArrayNode{nullptr};
+                node_pointer arrayNode{nullptr};
+                node_pointer workNode{nullptr};
+                for(size_type idx = 0; idx < arrayCapacity; ++idx)
+                {
+                    otherArrayNode = other.array[idx];
+                    arrayNode = array[idx];
+                    while (otherArrayNode != nullptr)
+                    {
+                        try
+                        {
+                            workNode = allocate_node();
+                            new(workNode) node_type{value_type(otherArrayNode->data), nullptr, nullptr};
+                            workNode->set_hash(node_hash(otherArrayNode));
+                        } catch (std::bad_alloc)
+                        {
+                            clear();
+                            return *this;
+                        } catch (...)
+                        {
+                            (*workNode).~node_type();
+                            deallocate_node(workNode);
+                            clear();
+                            return *this;
+                        }
+
+                        if(array[idx] == nullptr)
+                        {
+                            array[idx] = workNode;
+                            mark_occupied(idx);
+                            arrayNode = workNode;
+                        } else
+                        {
+                            arrayNode->next = workNode;
+                            workNode->previous = arrayNode;
+                            arrayNode = workNode;
+                        }
+
+                        otherArrayNode = otherArrayNode->next;
+                    }
+                }
+
+                if (!copy_pending_nodes(other))
+                {
+                    clear();
+                    return *this;
+                }
+            }
+            rebuild_bloom();
+
+            return *this;
+        }
+
+        HashTable(HashTable&& other) noexcept :
+        arrayAllocator(std::move(other.arrayAllocator)),
+        listAllocator(std::move(other.listAllocator)),
+        hashFun(std::move(other.hashFun)),
+        keyEqual(std::move(other.keyEqual)),
+        tableSize(std::move(other.tableSize)),
+        arrayCapacity(std::move(other.arrayCapacity)),
+        array(std::move(other.array)),
+        oldCapacity(std::move(other.oldCapacity)),
+        oldArray(std::move(other.oldArray)),
+        migrateIndex(std::move(other.migrateIndex)),
+        rehashStep(std::move(other.rehashStep)),
+        occupancy(std::move(other.occupancy)),
+        occupancyWords(std::move(other.occupancyWords)),
+        maxLoadFactor(other.maxLoadFactor),
+        shrinkLoadFactor(other.shrinkLoadFactor),
+        bloomFilter(other.bloomFilter), bloomBlocks(other.bloomBlocks),
+        bloomBitsPerKey(other.bloomBitsPerKey), bloomRemoved(other.bloomRemoved),
+        bloomPending(other.bloomPending), bloomPendingBlocks(other.bloomPendingBlocks)
+        {
+            other.tableSize = 0;
+            other.arrayCapacity = 0;
+            other.array = nullptr;
+            other.oldCapacity = 0;
+            other.oldArray = nullptr;
+            other.migrateIndex = 0;
+            other.occupancy = nullptr;
+            other.occupancyWords = 0;
+            other.bloomFilter = nullptr;
+            other.bloomBlocks = 0;
+            other.bloomRemoved = 0;
+            other.bloomPending = nullptr;
+            other.bloomPendingBlocks = 0;
+        }
+
+        HashTable& operator = (HashTable&& other) noexcept
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if (arrayCapacity > 0 && array != nullptr)
+            {
+                free_nodes();
+                arrayAllocator.deallocate(array, arrayCapacity);
+            }
+            free_old_array();
+            free_occupancy();
+            free_bloom();
+
+            arrayAllocator = std::move(other.arrayAllocator);
+            listAllocator = std::move(other.listAllocator);
+            hashFun = std::move(other.hashFun);
+            keyEqual = std::move(other.keyEqual);
+            tableSize = std::move(other.tableSize);
+            arrayCapacity = std::move(other.arrayCapacity);
+            array = std::move(other.array);
+            oldCapacity = std::move(other.oldCapacity);
+            oldArray = std::move(other.oldArray);
+            migrateIndex = std::move(other.migrateIndex);
+            rehashStep = std::move(other.rehashStep);
+            occupancy = std::move(other.occupancy);
+            occupancyWords = std::move(other.occupancyWords);
+            maxLoadFactor = other.maxLoadFactor;
+            shrinkLoadFactor = other.shrinkLoadFactor;
+            bloomFilter = other.bloomFilter;
+            bloomBlocks = other.bloomBlocks;
+            bloomBitsPerKey = other.bloomBitsPerKey;
+            bloomRemoved = other.bloomRemoved;
+            bloomPending = other.bloomPending;
+            bloomPendingBlocks = other.bloomPendingBlocks;
+
+            other.tableSize = 0;
+            other.arrayCapacity = 0;
+            other.array = nullptr;
+            other.oldCapacity = 0;
+            other.oldArray = nullptr;
+            other.migrateIndex = 0;
+            other.occupancy = nullptr;
+            other.occupancyWords = 0;
+            other.bloomFilter = nullptr;
+            other.bloomBlocks = 0;
+            other.bloomRemoved = 0;
+            other.bloomPending = nullptr;
+            other.bloomPendingBlocks = 0;
+
+            return *this;
+        }
+
+        virtual ~HashTable()
+        {
+            if (arrayCapacity > 0 && array != nullptr)
+            {
+                free_nodes();
+                arrayAllocator.deallocate(array, arrayCapacity);
+            }
+            free_old_array();
+            free_occupancy();
+            free_bloom();
+        }
+
+        [[nodiscard]] inline iterator begin() noexcept
+        {
+            const_cast<HashTable*>(this)->finish_rehash();
+            if (tableSize == 0)
+            {
+                return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+            }
+
+            const size_type index = next_occupied(0);
+            return iterator(index, const_cast<HashTable*>(this), array[index]);
+        }
+
+        [[nodiscard]] inline const_iterator begin() const noexcept
+        {
+            if (tableSize == 0)
+            {
+                return const_iterator(end_slot(), const_cast<HashTable*>(this), nullptr);
+            }
+
+            const size_type index = next_slot(0);
+            return const_iterator(index, const_cast<HashTable*>(this), slot_node(index));
+        }
+
+        [[nodiscard]] inline const_iterator cbegin() const noexcept
+        {
+            if (tableSize == 0)
+            {
+                return const_iterator(end_slot(), const_cast<HashTable*>(this), nullptr);
+            }
+
+            const size_type index = next_slot(0);
+            return const_iterator(index, const_cast<HashTable*>(this), slot_node(index));
+        }
+
+        [[nodiscard]] inline iterator end() noexcept
+        {
+            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+        }
+
+        [[nodiscard]] inline const_iterator end() const noexcept
+        {
+            return const_iterator(end_slot(), const_cast<HashTable*>(this), nullptr);
+        }
+
+        [[nodiscard]] inline const_iterator cend() const noexcept
+        {
+            return const_iterator(end_slot(), const_cast<HashTable*>(this), nullptr);
+        }
+
+        [[nodiscard]] inline view_iterator view_begin() noexcept
+        {
+            finish_rehash();
+            const size_type index = next_occupied(0);
+            return view_iterator(index, this, index < arrayCapacity ? array[index] : nullptr);
+        }
+
+        [[nodiscard]] inline const_view_iterator view_begin() const noexcept
+        {
+            return cview_begin();
+        }
+
+        [[nodiscard]] inline const_view_iterator cview_begin() const noexcept
+        {
+            const size_type index = next_slot(0);
+            return const_view_iterator(index, this, slot_node(index));
+        }
+
+        [[nodiscard]] inline view_iterator view_end() noexcept
+        {
+            return view_iterator(arrayCapacity, this, nullptr);
+        }
+
+        [[nodiscard]] inline const_view_iterator view_end() const noexcept
+        {
+            return cview_end();
+        }
+
+        [[nodiscard]] inline const_view_iterator cview_end() const noexcept
+        {
+            return const_view_iterator(end_slot(), this, nullptr);
+        }
+
+        [[nodiscard]] inline view_type view() noexcept
+        {
+            return view_type(view_begin(), view_end());
+        }
+
+        [[nodiscard]] inline const_view_type view() const noexcept
+        {
+            return const_view_type(cview_begin(), cview_end());
+        }
+
+        void enable_bloom_filter(const size_type bitsPerKey = 10)
+        {
+            bloomBitsPerKey = bitsPerKey;
+            rebuild_bloom();
+        }
+
+        void disable_bloom_filter() noexcept
+        {
+            bloomBitsPerKey = 0;
+            free_bloom();
+        }
+
+        [[nodiscard]] inline bool bloom_filter_enabled() const noexcept
+        {
+            return bloomFilter != nullptr;
+        }
+
+        [[nodiscard]] frozen_type freeze() const
+        {
+            return frozen_type(cview_begin(), cview_end(), hashFun, keyEqual);
+        }
+
+#if defined(BICE_HASH_TABLE_STATS)
+        [[nodiscard]] HashTableStats stats() const noexcept
+        {
+            HashTableStats result = counters;
+            result.size = tableSize;
+            result.capacity = arrayCapacity;
+            result.loadFactor = arrayCapacity == 0 ? 0.0f : load_factor();
+            chain_histogram(array, arrayCapacity, result);
+            chain_histogram(oldArray, oldCapacity, result);
+            return result;
+        }
+
+        void reset_stats() noexcept
+        {
+            counters = HashTableStats{};
+        }
+#endif
+
+        [[nodiscard]] size_type next_occupied(const size_type index) const noexcept
+        {
+            if (index >= arrayCapacity)
+            {
+                return arrayCapacity;
+            }
+
+            size_type word = index >> 6;
+            std::uint64_t bits = occupancy[word] & (~std::uint64_t{0} << (index & 63));
+            while (bits == 0)
+            {
+                ++word;
+                if (word >= occupancyWords)
+                {
+                    return arrayCapacity;
+                }
+                bits = occupancy[word];
+            }
+            return std::min<size_type>((word << 6) + (size_type)std::countr_zero(bits), arrayCapacity);
+        }
+
+        [[nodiscard]] inline size_type end_slot() const noexcept
+        {
+            return oldArray != nullptr ? arrayCapacity + oldCapacity : arrayCapacity;
+        }
+
+        [[nodiscard]] size_type next_slot(const size_type index) const noexcept
+        {
+            const size_type nextIndex = next_occupied(index);
+            if (nextIndex < arrayCapacity || oldArray == nullptr)
+            {
+                return nextIndex;
+            }
+
+            for(size_type idx = std::max(index, arrayCapacity + migrateIndex); idx < arrayCapacity + oldCapacity; ++idx)
+            {
+                if (oldArray[idx - arrayCapacity] != nullptr)
+                {
+                    return idx;
+                }
+            }
+            return arrayCapacity + oldCapacity;
+        }
+
+        [[nodiscard]] inline node_pointer slot_node(const size_type index) const noexcept
+        {
+            if (index < arrayCapacity)
+            {
+                return array[index];
+            }
+            return index < end_slot() ? oldArray[index - arrayCapacity] : nullptr;
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return tableSize;
+        }
+
+        [[nodiscard]] inline size_type capacity() const noexcept
+        {
+            return arrayCapacity;
+        }
+
+        [[nodiscard]] inline size_type max_size() const noexcept
+        {
+            return std::numeric_limits<size_type>::max();
+        }
+
+        [[nodiscard]] inline float load_factor() const noexcept
+        {
+            auto n = (float)tableSize;
+            auto m = (float)arrayCapacity;
+
+            return n / m;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return tableSize == 0;
+        }
+
+        [[nodiscard]] inline array_type get_array() noexcept
+        {
+            return array;
+        }
+
+        [[nodiscard]] inline const_array_type get_array() const noexcept
+        {
+            return array;
+        }
+
+        [[nodiscard]] inline bool rehashing() const noexcept
+        {
+            return oldArray != nullptr;
+        }
+
+        [[nodiscard]] inline size_type rehash_step() const noexcept
+        {
+            return rehashStep;
+        }
+
+        void set_rehash_step(const size_type bucketsPerStep) noexcept
+        {
+            rehashStep = bucketsPerStep;
+        }
+
+        void finish_rehash() noexcept
+        {
+            if (oldArray != nullptr)
+            {
+                timed_migration([this]() { migrate_buckets(oldCapacity); });
+            }
+        }
+
+        [[nodiscard]] inline float max_load_factor() const noexcept
+        {
+            return maxLoadFactor;
+        }
+
+        void max_load_factor(const float loadFactor)
+        {
+            if (loadFactor > 0.0f)
+            {
+                maxLoadFactor = loadFactor;
+                shrinkLoadFactor = std::min(shrinkLoadFactor, maxLoadFactor / 4.0f);
+                if (arrayCapacity > 0 && load_factor() > maxLoadFactor)
+                {
+                    rehash(0);
+                }
+            }
+        }
+
+        [[nodiscard]] inline float shrink_load_factor() const noexcept
+        {
+            return shrinkLoadFactor;
+        }
+
+        void set_shrink_load_factor(const float loadFactor) noexcept
+        {
+            shrinkLoadFactor = std::clamp(loadFactor, 0.0f, maxLoadFactor / 4.0f);
+        }
+
+        void reserve(const size_type& count, const size_type threadCount = 1)
+        {
+            const size_type newCapacity = BUCKET_POLICY::capacity_for(count);
+            if (count > 0 && newCapacity > arrayCapacity)
+            {
+                resize_array(newCapacity, threadCount);
+            }
+        }
+
+        void rehash(const size_type count, const size_type threadCount = 1)
+        {
+            const auto minimumCount = (size_type)std::ceil((double)tableSize / (double)maxLoadFactor);
+            const size_type newCapacity = BUCKET_POLICY::capacity_for(std::max<size_type>({count, minimumCount, 1}));
+            if (newCapacity != arrayCapacity)
+            {
+                resize_array(newCapacity, threadCount);
+            }
+        }
+
+        void insert(const_reference value)
+        {
+            if (!ensure_array())
+            {
+                return;
+            }
+            grow_if_needed();
+
+            node_pointer workNode{nullptr};
+            try
+            {
+                workNode = allocate_node();
+                new(workNode) node_type{value_type(value), nullptr, nullptr};
+            } catch (std::bad_alloc)
+            {
+                return;
+            } catch (...)
+            {
+                deallocate_node(workNode);
+                return;
+            }
+
+            link_node(workNode);
+        }
+
+        void insert(value_type&& value)
+        {
+            if (!ensure_array())
+            {
+                return;
+            }
+            grow_if_needed();
+
+            node_pointer workNode{nullptr};
+            try
+            {
+                workNode = allocate_node();
+            } catch (std::bad_alloc)
+            {
+                return;
+            }
+
+            new(workNode) node_type{value_type(std::move(value)), nullptr, nullptr};
+
+            link_node(workNode);
+        }
+
+        template<typename... Args>
+        void emplace(Args... args)
+        {
+            if (!ensure_array())
+            {
+                return;
+            }
+            grow_if_needed();
+
+            node_pointer workNode{nullptr};
+            try
+            {
+                workNode = allocate_node();
+                new(workNode) node_type{value_type(std::forward<Args>(args)...), nullptr, nullptr};
+            } catch (std::bad_alloc)
+            {
+                return;
+            } catch (...)
+            {
+                deallocate_node(workNode);
+                return;
+            }
+
+            link_node(workNode);
+        }
+
+        template<typename ITERATOR> requires std::random_access_iterator<ITERATOR>
+        void insert(const ITERATOR begin, const ITERATOR end, const size_type threadCount = 1)
+        {
+            const difference_type distance = end - begin;
+            if (distance <= 0)
+            {
+                return;
+            }
+
+            const auto count = (size_type)distance;
+            const auto bucketCount = (size_type)std::ceil((double)(tableSize + count) / (double)maxLoadFactor);
+            const size_type newCapacity = BUCKET_POLICY::capacity_for(std::max<size_type>(bucketCount, BUCKET_POLICY::initial_capacity));
+            if (newCapacity > arrayCapacity)
+            {
+                resize_array(newCapacity, threadCount);
+            }
+            finish_rehash();
+            if (array == nullptr)
+            {
+                return;
+            }
+
+            const size_type workerCount = worker_count(threadCount, count);
+            const size_type bucketSpan = ((arrayCapacity + workerCount - 1) / workerCount + 63) / 64 * 64;
+
+            std::vector<node_pointer> workNodes;
+            std::vector<node_pointer> groupedNodes;
+            std::vector<size_type> destinations;
+            std::vector<size_type> rangeCounts;
+            std::vector<size_type> rangeStarts;
+            try
+            {
+                workNodes.resize(count);
+                groupedNodes.resize(count);
+                destinations.resize(count);
+                rangeCounts.resize(workerCount * workerCount);
+                rangeStarts.resize(workerCount + 1);
+            } catch (std::bad_alloc)
+            {
+                return;
+            }
+
+            if constexpr (requires(list_allocator_type& allocator_) { allocator_.reserve(count); })
+            {
+                try
+                {
+                    listAllocator.reserve(count);
+                } catch (std::bad_alloc)
+                {
+                    return;
+                }
+            }
+
+            for(size_type idx = 0; idx < count; ++idx)
+            {
+                try
+                {
+                    workNodes[idx] = allocate_node();
+                } catch (std::bad_alloc)
+                {
+                    for(size_type jdx = 0; jdx < idx; ++jdx)
+                    {
+                        deallocate_node(workNodes[jdx]);
+                    }
+                    return;
+                }
+            }
+
+            std::vector<size_type> constructed(workerCount, 0);
+            std::atomic<bool> failed{false};
+
+            run_workers(workerCount, [&](const size_type worker)
+            {
+                const size_type first = count * worker / workerCount;
+                const size_type last = count * (worker + 1) / workerCount;
+                for(size_type idx = first; idx < last && !failed.load(std::memory_order_relaxed); ++idx)
+                {
+                    try
+                    {
+                        new(workNodes[idx]) node_type{value_type(*(begin + (difference_type)idx)), nullptr, nullptr};
+                        const size_type keyHash = hash_key(workNodes[idx]->data.first);
+                        workNodes[idx]->set_hash(keyHash);
+                        destinations[idx] = BUCKET_POLICY::index(keyHash, arrayCapacity);
+                        bloom_add_atomic(keyHash);
+                    } catch (...)
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                    ++constructed[worker];
+                    ++rangeCounts[worker * workerCount + destinations[idx] / bucketSpan];
+                }
+            });
+
+            if (failed.load())
+            {
+                for(size_type worker = 0; worker < workerCount; ++worker)
+                {
+                    const size_type first = count * worker / workerCount;
+                    for(size_type idx = first; idx < first + constructed[worker]; ++idx)
+                    {
+                        (*workNodes[idx]).~node_type();
+                    }
+                }
+                for(size_type idx = 0; idx < count; ++idx)
+                {
+                    deallocate_node(workNodes[idx]);
+                }
+                return;
+            }
+
+            size_type offset{0};
+            size_type rangeCount{0};
+            for(size_type range = 0; range < workerCount; ++range)
+            {
+                rangeStarts[range] = offset;
+                for(size_type worker = 0; worker < workerCount; ++worker)
+                {
+                    rangeCount = rangeCounts[worker * workerCount + range];
+                    rangeCounts[worker * workerCount + range] = offset;
+                    offset += rangeCount;
+                }
+            }
+            rangeStarts[workerCount] = offset;
+
+            run_workers(workerCount, [&](const size_type worker)
+            {
+                const size_type first = count * worker / workerCount;
+                const size_type last = count * (worker + 1) / workerCount;
+                size_type* offsets = rangeCounts.data() + worker * workerCount;
+                for(size_type idx = first; idx < last; ++idx)
+                {
+                    groupedNodes[offsets[destinations[idx] / bucketSpan]++] = workNodes[idx];
+                }
+            });
+
+            run_workers(workerCount, [&](const size_type worker)
+            {
+                for(size_type idx = rangeStarts[worker]; idx < rangeStarts[worker + 1]; ++idx)
+                {
+                    const size_type keyHash = node_hash(groupedNodes[idx]);
+                    link_grouped(groupedNodes[idx], keyHash, BUCKET_POLICY::index(keyHash, arrayCapacity));
+                }
+            });
+
+            tableSize += count;
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            return emplace_unique(key, std::piecewise_construct,
+                                  std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+        {
+            return emplace_unique(key, std::piecewise_construct,
+                                  std::forward_as_tuple(std::move(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template<typename MAPPED>
+        std::pair<iterator, bool> insert_or_assign(const key_type& key, MAPPED&& value)
+        {
+            std::pair<iterator, bool> result = try_emplace(key, std::forward<MAPPED>(value));
+            if (!result.second && result.first.get_node() != nullptr)
+            {
+                result.first.get_node()->data.second = std::forward<MAPPED>(value);
+            }
+            return result;
+        }
+
+        template<typename MAPPED>
+        std::pair<iterator, bool> insert_or_assign(key_type&& key, MAPPED&& value)
+        {
+            std::pair<iterator, bool> result = try_emplace(std::move(key), std::forward<MAPPED>(value));
+            if (!result.second && result.first.get_node() != nullptr)
+            {
+                result.first.get_node()->data.second = std::forward<MAPPED>(value);
+            }
+            return result;
+        }
+
+        iterator find(const key_type& key)
+        {
+            return find_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        iterator find(const K& key)
+        {
+            return find_key(key);
+        }
+
+        size_type find_many(std::span<const key_type> keys, std::span<pointer> results)
+        {
+            return find_many_keys(keys, results);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        size_type find_many(std::span<const K> keys, std::span<pointer> results)
+        {
+            return find_many_keys(keys, results);
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return contains_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return contains_key(key);
+        }
+
+        iterator find(const_reference value)
+        {
+            if (tableSize > 0)
+            {
+                const size_type keyHash = hash_key(value.first);
+                migrate_key(keyHash);
+                auto hashValue = BUCKET_POLICY::index(keyHash, arrayCapacity);
+                if (hashValue < arrayCapacity && hashValue >= 0)
+                {
+                    node_pointer arrayNode = array[hashValue];
+                    while (arrayNode != nullptr)
+                    {
+                        if (arrayNode->data == value)
+                        {
+                            return iterator(hashValue, const_cast<HashTable*>(this), arrayNode);
+                        }
+                        arrayNode = arrayNode->next;
+                    }
+                }
+            }
+            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+        }
+
+        iterator find(const mapped_type& value) requires (!std::is_same_v<KEY, VALUE>)
+        {
+            if (tableSize > 0)
+            {
+                finish_rehash();
+                node_pointer arrayNode{nullptr};
+                for(size_type idx = 0; idx < arrayCapacity; ++idx)
+                {
+                    arrayNode = array[idx];
+                    while (arrayNode != nullptr)
+                    {
+                        if (arrayNode->data.second == value)
+                        {
+                            return iterator(idx, const_cast<HashTable*>(this), arrayNode);
+                        }
+                        arrayNode = arrayNode->next;
+                    }
+                }
+            }
+
+            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+        }
+
+        std::pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            return equal_range_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        std::pair<iterator, iterator> equal_range(const K& key)
+        {
+            return equal_range_key(key);
+        }
+
+        view_type equal_view(const key_type& key)
+        {
+            return equal_view_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        view_type equal_view(const K& key)
+        {
+            return equal_view_key(key);
+        }
+
+        [[nodiscard]] size_type count(const key_type& key) const
+        {
+            return count_key(key);
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        [[nodiscard]] size_type count(const K& key) const
+        {
+            return count_key(key);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            const size_type count = remove_key(key);
+            shrink_if_needed();
+            return count;
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        size_type erase(const K& key)
+        {
+            const size_type count = remove_key(key);
+            shrink_if_needed();
+            return count;
+        }
+
+        void remove(const key_type& key)
+        {
+            remove_key(key);
+            shrink_if_needed();
+        }
+
+        template<typename K> requires is_transparent_key<K>
+        void remove(const K& key)
+        {
+            remove_key(key);
+            shrink_if_needed();
+        }
+
+        void remove(iterator removeIterator)
+        {
+            unlink_node(removeIterator.get_node(), removeIterator.get_index());
+            shrink_if_needed();
+        }
+
+        void remove(const mapped_type& value) requires (!std::is_same_v<KEY, VALUE>)
+        {
+            iterator findIterator = find(value);
+            if (findIterator != end())
+            {
+                unlink_node(findIterator.get_node(), findIterator.get_index());
+                shrink_if_needed();
+            }
+        }
+
+        void clear()
+        {
+            if (tableSize > 0)
+            {
+                free_nodes();
+                for(size_type idx = 0; idx < arrayCapacity; ++idx)
+                {
+                    array[idx] = nullptr;
+                }
+                for(size_type idx = 0; idx < occupancyWords; ++idx)
+                {
+                    occupancy[idx] = 0;
+                }
+                free_old_array();
+                for(size_type idx = 0; idx < bloomBlocks * bloom_block_words; ++idx)
+                {
+                    bloomFilter[idx] = 0;
+                }
+                tableSize = 0;
+                bloomRemoved = 0;
+            }
+        }
+
+        [[nodiscard]] inline bool operator == (const HashTable& other) const noexcept
+        {
+            bool equal = true;
+
+            if (tableSize == other.tableSize)
+            {
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        equal = false;
+                        break;
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else
+            {
+                equal = false;
+            }
+            return equal;
+        }
+
+        [[nodiscard]] inline bool operator != (const HashTable& other) const noexcept
+        {
+            bool equal = false;
+            if (tableSize == other.tableSize)
+            {
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        equal = true;
+                        break;
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else
+            {
+                equal = true;
+            }
+            return equal;
+        }
+
+        [[nodiscard]] inline bool operator >= (const HashTable& other) const noexcept
+        {
+            bool equal;
+
+            if (tableSize == other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            break;
+                        } else
+                        {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else if (tableSize > other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (right != other.cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            break;
+                        } else
+                        {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+
+            } else if (tableSize < other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
+                        {
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            }
+
+            return equal;
+        }
+
+        [[nodiscard]] inline bool operator > (const HashTable& other) const noexcept
+        {
+            bool equal;
+
+            if (tableSize == other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
+                        {
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else if (tableSize > other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (right != other.cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            break;
+                        } else
+                        {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else if (tableSize < other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left > *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
+                        {
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            }
+
+            return equal;
+        }
+
+        [[nodiscard]] inline bool operator <= (const HashTable& other) const noexcept
+        {
+            bool equal;
+
+            if (tableSize == other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
+                        {
+                            break;
+                        } else
+                        {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+
+            } else if (tableSize > other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (right != other.cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
+                        {
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+
+            } else if (tableSize < other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
+                        {
+                            break;
+                        } else
+                        {
+                            equal = false;
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            }
+
+            return equal;
+        }
+
+        [[nodiscard]] inline bool operator < (const HashTable& other) const noexcept
+        {
+            bool equal;
+
+            if (tableSize == other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
+                        {
+                            break;
+                        }
+                    }
+                    ++left;
+                    ++right;
+                }
+            } else if (tableSize > other.tableSize)
+            {
+                equal = false;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
+
+                while (right != other.cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
+                        {
+                            equal = true;
+                            break;
+                        } else
                         {
-                            (*workNode).~node_type();
-                            listAllocator.deallocate(workNode, 1);
-                            clear();
-                            return *this;
+                            break;
                         }
+                    }
+                    ++left;
+                    ++right;
+                }
+
+            } else if (tableSize < other.tableSize)
+            {
+                equal = true;
+                const_view_iterator left = cview_begin();
+                const_view_iterator right = other.cview_begin();
 
-                        if(array[idx] == arrayNode)
+                while (left != cview_end())
+                {
+                    if (*left != *right)
+                    {
+                        if (*left < *right)
                         {
-                            array[idx] = workNode;
-                            arrayNode = workNode;
+                            break;
                         } else
                         {
-                            arrayNode->next = workNode;
-                            workNode->previous = arrayNode;
-                            arrayNode = workNode;
+                            equal = false;
+                            break;
                         }
-
-                        otherArrayNode = otherArrayNode->next;
                     }
+                    ++left;
+                    ++right;
                 }
             }
 
-            return *this;
+            return equal;
         }
+        
+    private:
 
-        HashTable(HashTable&& other) noexcept :
-        arrayAllocator(std::move(other.arrayAllocator)),
-        listAllocator(std::move(other.listAllocator)),
-        hashFun(std::move(other.hashFun)),
-        keyEqual(std::move(other.keyEqual)),
-        tableSize(std::move(other.tableSize)),
-        arrayCapacity(std::move(other.arrayCapacity)),
-        array(std::move(other.array))
+        array_allocator_type arrayAllocator;
+        list_allocator_type listAllocator;
+        hasher hashFun;
+        key_equal keyEqual;
+        size_type tableSize;
+        size_type arrayCapacity;
+        node_pointer* array;
+        size_type oldCapacity;
+        node_pointer* oldArray;
+        size_type migrateIndex;
+        size_type rehashStep;
+        std::uint64_t* occupancy;
+        size_type occupancyWords;
+        float maxLoadFactor;
+        float shrinkLoadFactor;
+        std::uint64_t* bloomFilter;
+        size_type bloomBlocks;
+        size_type bloomBitsPerKey;
+        size_type bloomRemoved;
+        std::uint64_t* bloomPending;
+        size_type bloomPendingBlocks;
+
+#if defined(BICE_HASH_TABLE_STATS)
+        mutable HashTableStats counters{};
+
+        static void chain_histogram(node_pointer* bucketArray, const size_type capacity, HashTableStats& result) noexcept
         {
-            other.tableSize = 0;
-            other.arrayCapacity = 0;
-            other.array = nullptr;
+            for(size_type idx = 0; bucketArray != nullptr && idx < capacity; ++idx)
+            {
+                size_type chainLength{0};
+                for(node_pointer arrayNode = bucketArray[idx]; arrayNode != nullptr; arrayNode = arrayNode->next)
+                {
+                    ++chainLength;
+                }
+                ++result.chainLengthHistogram[std::min(chainLength, HashTableStats::histogram_size - 1)];
+                result.maxChainLength = std::max(result.maxChainLength, chainLength);
+            }
         }
+#endif
 
-        HashTable& operator = (HashTable&& other) noexcept
+        inline void count_lookup(const size_type probes) const noexcept
         {
-            arrayAllocator = std::move(other.arrayAllocator);
-            listAllocator = std::move(other.listAllocator);
-            hashFun = std::move(other.hashFun);
-            keyEqual = std::move(other.keyEqual);
-            tableSize = std::move(other.tableSize);
-            arrayCapacity = std::move(other.arrayCapacity);
-            array = std::move(other.array);
-
-            other.tableSize = 0;
-            other.arrayCapacity = 0;
-            other.array = nullptr;
+#if defined(BICE_HASH_TABLE_STATS)
+            ++counters.lookupCount;
+            counters.probeCount += probes;
+            counters.maxProbes = std::max(counters.maxProbes, probes);
+#else
+            (void)probes;
+#endif
+        }
 
-            return *this;
+        node_pointer allocate_node()
+        {
+            node_pointer workNode = listAllocator.allocate(1);
+#if defined(BICE_HASH_TABLE_STATS)
+            ++counters.nodeAllocations;
+#endif
+            return workNode;
         }
 
-        virtual ~HashTable()
+        void deallocate_node(node_pointer workNode) noexcept
         {
-            if (arrayCapacity > 0 && array != nullptr)
-            {
-                if (tableSize > 0)
-                {
-                    node_pointer arrayNode{nullptr};
-                    node_pointer deleteNode{nullptr};
+            listAllocator.deallocate(workNode, 1);
+#if defined(BICE_HASH_TABLE_STATS)
+            ++counters.nodeDeallocations;
+#endif
+        }
 
-                    for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                    {
-                        arrayNode = array[idx];
-                        deleteNode = arrayNode;
-                        while (arrayNode != nullptr)
-                        {
-                            arrayNode = arrayNode->next;
-                            (*deleteNode).~node_type();
-                            listAllocator.deallocate(deleteNode, 1);
-                            deleteNode = arrayNode;
-                        }
-                    }
-                }
-                arrayAllocator.deallocate(array, arrayCapacity);
-            }
+        node_pointer* allocate_buckets(const size_type count)
+        {
+            node_pointer* workArray = arrayAllocator.allocate(count);
+#if defined(BICE_HASH_TABLE_STATS)
+            ++counters.bucketArrayAllocations;
+#endif
+            return workArray;
         }
 
-        [[nodiscard]] inline iterator begin() noexcept
+        using occupancy_allocator_type                 = typename std::allocator_traits<ARRAY_ALLOCATOR>::template rebind_alloc<std::uint64_t>;
+
+        bool allocate_occupancy(const size_type capacity)
         {
-            size_type index = 0;
-            node_pointer arrayNode = array[0];
-            while (arrayNode == nullptr)
+            const size_type words = (capacity + 63) / 64;
+            occupancy_allocator_type occupancyAllocator(arrayAllocator);
+            std::uint64_t* workBits{nullptr};
+            try
+            {
+                workBits = occupancyAllocator.allocate(words);
+            } catch (std::bad_alloc)
             {
-                ++index;
-                arrayNode = array[index];
+                return false;
             }
-            return iterator(index, const_cast<HashTable*>(this), array[index]);
-        }
 
-        [[nodiscard]] inline const_iterator begin() const noexcept
-        {
-            size_type index = 0;
-            node_pointer arrayNode = array[0];
-            while (arrayNode == nullptr)
+            for(size_type idx = 0; idx < words; ++idx)
             {
-                ++index;
-                arrayNode = array[index];
+                workBits[idx] = 0;
             }
-            return const_iterator(index, const_cast<HashTable*>(this), array[index]);
+
+            free_occupancy();
+            occupancy = workBits;
+            occupancyWords = words;
+            return true;
         }
 
-        [[nodiscard]] inline const_iterator cbegin() const noexcept
+        void free_occupancy() noexcept
         {
-            size_type index = 0;
-            node_pointer arrayNode = array[0];
-            while (arrayNode == nullptr)
+            if (occupancy != nullptr)
             {
-                ++index;
-                arrayNode = array[index];
+                occupancy_allocator_type occupancyAllocator(arrayAllocator);
+                occupancyAllocator.deallocate(occupancy, occupancyWords);
             }
-            return const_iterator(index, const_cast<HashTable*>(this), array[index]);
+            occupancy = nullptr;
+            occupancyWords = 0;
         }
 
-        [[nodiscard]] inline iterator end() noexcept
+        inline void mark_occupied(const size_type index) noexcept
         {
-            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+            occupancy[index >> 6] |= std::uint64_t{1} << (index & 63);
         }
 
-        [[nodiscard]] inline const_iterator end() const noexcept
+        inline void mark_empty(const size_type index) noexcept
         {
-            return const_iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+            occupancy[index >> 6] &= ~(std::uint64_t{1} << (index & 63));
         }
 
-        [[nodiscard]] inline const_iterator cend() const noexcept
+        template<typename K>
+        [[nodiscard]] inline size_type hash_key(const K& key) const
         {
-            return const_iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+            return (size_type)hashFun(key);
         }
 
-        [[nodiscard]] inline size_type size() const noexcept
+        [[nodiscard]] inline size_type node_hash(const node_type* node) const
         {
-            return tableSize;
+            if constexpr (node_type::cached_hash)
+            {
+                return node->hash;
+            } else
+            {
+                return hash_key(node->data.first);
+            }
         }
 
-        [[nodiscard]] inline size_type capacity() const noexcept
+        template<typename K>
+        [[nodiscard]] inline bool node_matches(const node_type* node, const size_type keyHash, const K& key) const
         {
-            return arrayCapacity;
+            if constexpr (node_type::cached_hash)
+            {
+                return node->hash == keyHash && keyEqual(node->data.first, key);
+            } else
+            {
+                return keyEqual(node->data.first, key);
+            }
         }
 
-        [[nodiscard]] inline size_type max_size() const noexcept
+        static constexpr size_type bloom_block_words   = 8;
+        static constexpr size_type bloom_block_bytes   = bloom_block_words * sizeof(std::uint64_t);
+
+        [[nodiscard]] static inline std::uint64_t bloom_bit(const size_type mixedHash, const size_type word) noexcept
         {
-            return std::numeric_limits<size_type>::max();
+            constexpr std::uint32_t salts[bloom_block_words]{
+                0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+            };
+            return (std::uint64_t)1 << (((std::uint32_t)mixedHash * salts[word]) >> 26);
         }
 
-        [[nodiscard]] inline float load_factor() const noexcept
+        [[nodiscard]] static inline std::uint64_t* bloom_block(std::uint64_t* filter, const size_type blocks, const size_type mixedHash) noexcept
         {
-            auto n = (float)tableSize;
-            auto m = (float)arrayCapacity;
+            return filter + ((mixedHash >> 32) & (blocks - 1)) * bloom_block_words;
+        }
 
-            return n / m;
+        static inline void bloom_set(std::uint64_t* filter, const size_type blocks, const size_type keyHash) noexcept
+        {
+            if (filter != nullptr)
+            {
+                const size_type mixedHash = keyHash * 0x9e3779b97f4a7c15ull;
+                std::uint64_t* block = bloom_block(filter, blocks, mixedHash);
+                for(size_type idx = 0; idx < bloom_block_words; ++idx)
+                {
+                    block[idx] |= bloom_bit(mixedHash, idx);
+                }
+            }
         }
 
-        [[nodiscard]] inline bool empty() const noexcept
+        static inline void bloom_set_atomic(std::uint64_t* filter, const size_type blocks, const size_type keyHash) noexcept
         {
-            return tableSize == 0;
+            if (filter != nullptr)
+            {
+                const size_type mixedHash = keyHash * 0x9e3779b97f4a7c15ull;
+                std::uint64_t* block = bloom_block(filter, blocks, mixedHash);
+                for(size_type idx = 0; idx < bloom_block_words; ++idx)
+                {
+                    std::atomic_ref<std::uint64_t>(block[idx]).fetch_or(bloom_bit(mixedHash, idx), std::memory_order_relaxed);
+                }
+            }
         }
 
-        [[nodiscard]] inline array_type get_array() noexcept
+        inline void bloom_add(const size_type keyHash) noexcept
         {
-            return array;
+            bloom_set(bloomFilter, bloomBlocks, keyHash);
+            bloom_set(bloomPending, bloomPendingBlocks, keyHash);
         }
 
-        [[nodiscard]] inline const_array_type get_array() const noexcept
+        inline void bloom_add_atomic(const size_type keyHash) noexcept
         {
-            return array;
+            bloom_set_atomic(bloomFilter, bloomBlocks, keyHash);
+            bloom_set_atomic(bloomPending, bloomPendingBlocks, keyHash);
         }
 
-        void reserve(const size_type& newCapacity)
+        [[nodiscard]] inline bool bloom_may_contain(const size_type keyHash) const noexcept
         {
-            if (newCapacity > 0 && newCapacity > arrayCapacity)
+            if (bloomFilter == nullptr)
             {
-                node_pointer* workArray{nullptr};
-                node_pointer* workIterator{nullptr};
-                try
-                {
-                    workArray = arrayAllocator.allocate(newCapacity);
-                } catch (std::bad_alloc)
-                {
-                    return;
-                }
-
-                workIterator = workArray;
+                return true;
+            }
 
-                for(size_type idx = 0; idx < newCapacity; ++idx)
-                {
-                    *workIterator = nullptr;
-                    ++workIterator;
-                }
+            const size_type mixedHash = keyHash * 0x9e3779b97f4a7c15ull;
+            const std::uint64_t* block = bloom_block(bloomFilter, bloomBlocks, mixedHash);
+            std::uint64_t missing{0};
+            for(size_type idx = 0; idx < bloom_block_words; ++idx)
+            {
+                missing |= bloom_bit(mixedHash, idx) & ~block[idx];
+            }
 
-                node_pointer arrayNode{nullptr};
-                node_pointer workNode{nullptr};
-                node_pointer insertNode{nullptr};
+#if defined(BICE_HASH_TABLE_STATS)
+            if (missing != 0)
+            {
+                ++counters.bloomRejections;
+            }
+#endif
+            return missing == 0;
+        }
 
-                for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                {
-                    arrayNode = array[idx];
-                    while (arrayNode != nullptr)
-                    {
-                        insertNode = arrayNode;
-                        auto key = arrayNode->data.first;
-                        auto hashValue = (size_type)hashFun(key) % newCapacity;
-                        workNode = workArray[hashValue];
+        void free_bloom() noexcept
+        {
+            if (bloomFilter != nullptr)
+            {
+                ::operator delete(bloomFilter, std::align_val_t(bloom_block_bytes));
+            }
+            bloomFilter = nullptr;
+            bloomBlocks = 0;
+            bloomRemoved = 0;
+            if (bloomPending != nullptr)
+            {
+                ::operator delete(bloomPending, std::align_val_t(bloom_block_bytes));
+            }
+            bloomPending = nullptr;
+            bloomPendingBlocks = 0;
+        }
 
-                        if (workNode == nullptr)
-                        {
-                            workNode = insertNode;
-                            insertNode->previous = nullptr;
-                            insertNode->next = nullptr;
-                        } else
-                        {
-                            while (workNode->next != nullptr)
-                            {
-                                workNode = workNode->next;
-                            }
-                            workNode->next = insertNode;
-                            insertNode->previous = workNode;
-                            insertNode->next = nullptr;
-                        }
+        [[nodiscard]] inline size_type bloom_blocks_for(const size_type capacity) const noexcept
+        {
+            const auto expectedKeys = std::max<size_type>((size_type)std::ceil((double)capacity * (double)maxLoadFactor), tableSize);
+            return std::bit_ceil(std::max<size_type>((expectedKeys * bloomBitsPerKey + bloom_block_bytes * 8 - 1) / (bloom_block_bytes * 8), 1));
+        }
 
-                        arrayNode = arrayNode->next;
-                    }
-                }
+        [[nodiscard]] static std::uint64_t* allocate_bloom(const size_type blocks) noexcept
+        {
+            std::uint64_t* filter{nullptr};
+            try
+            {
+                filter = static_cast<std::uint64_t*>(::operator new(blocks * bloom_block_bytes, std::align_val_t(bloom_block_bytes)));
+            } catch (std::bad_alloc)
+            {
+                return nullptr;
+            }
 
-                arrayAllocator.deallocate(array, arrayCapacity);
-                array = workArray;
-                arrayCapacity = newCapacity;
+            for(size_type idx = 0; idx < blocks * bloom_block_words; ++idx)
+            {
+                filter[idx] = 0;
             }
+            return filter;
         }
 
-        void insert(const_reference value)
+        [[nodiscard]] inline bool bloom_stale() const noexcept
         {
-            if (arrayCapacity == 0 && array == nullptr)
-            {
-                node_pointer* workArray{nullptr};
-                node_pointer* workIterator{nullptr};
-                const size_type count = 11;
-                try
-                {
-                    workArray = arrayAllocator.allocate(count);
-                } catch (std::bad_alloc)
-                {
-                    return;
-                }
-
-                workIterator = workArray;
-                for(size_type idx = 0; idx < count; ++idx)
-                {
-                    *workIterator = nullptr;
-                    ++workIterator;
-                }
+            return bloomFilter != nullptr && bloomRemoved > std::max(tableSize, arrayCapacity);
+        }
 
-                arrayCapacity = count;
-                array = workArray;
+        void begin_bloom_migration() noexcept
+        {
+            const size_type blocks = bloom_blocks_for(arrayCapacity);
+            if (bloomFilter == nullptr || blocks == bloomBlocks)
+            {
+                return;
             }
 
-            auto loadFactor = load_factor();
-            if (loadFactor >= 3.0f)
+            bloomPending = allocate_bloom(blocks);
+            bloomPendingBlocks = bloomPending != nullptr ? blocks : 0;
+        }
+
+        void finish_bloom_migration() noexcept
+        {
+            if (bloomPending != nullptr)
             {
-                reserve(arrayCapacity * 2);
+                ::operator delete(bloomFilter, std::align_val_t(bloom_block_bytes));
+                bloomFilter = bloomPending;
+                bloomBlocks = bloomPendingBlocks;
+                bloomPending = nullptr;
+                bloomPendingBlocks = 0;
             }
+        }
 
-            node_pointer workNode{nullptr};
-            node_pointer arrayNode{nullptr};
-            try
-            {
-                workNode = listAllocator.allocate(1);
-                new(workNode) node_type{value_type(value), nullptr, nullptr};
-            } catch (std::bad_alloc)
+        void rebuild_bloom()
+        {
+            free_bloom();
+            if (bloomBitsPerKey == 0 || arrayCapacity == 0)
             {
                 return;
-            } catch (...)
+            }
+
+            const size_type blocks = bloom_blocks_for(arrayCapacity);
+            bloomFilter = allocate_bloom(blocks);
+            if (bloomFilter == nullptr)
             {
-                (*workNode).~node_type();
-                listAllocator.deallocate(workNode, 1);
                 return;
             }
+            bloomBlocks = blocks;
 
-            auto key = workNode->data.first;
-            auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-            arrayNode = array[hashValue];
-            if (arrayNode == nullptr)
-            {
-                array[hashValue] = workNode;
-            } else
+            for(size_type idx = 0; idx < arrayCapacity; ++idx)
             {
-                while (arrayNode->next != nullptr)
+                for(node_pointer arrayNode = array[idx]; arrayNode != nullptr; arrayNode = arrayNode->next)
                 {
-                    arrayNode = arrayNode->next;
+                    bloom_add(node_hash(arrayNode));
                 }
-
-                arrayNode->next = workNode;
-                workNode->previous = arrayNode;
             }
 
-            ++tableSize;
+            for(size_type idx = 0; oldArray != nullptr && idx < oldCapacity; ++idx)
+            {
+                for(node_pointer arrayNode = oldArray[idx]; arrayNode != nullptr; arrayNode = arrayNode->next)
+                {
+                    bloom_add(node_hash(arrayNode));
+                }
+            }
         }
 
-        void insert(value_type&& value)
+        bool ensure_array()
         {
             if (arrayCapacity == 0 && array == nullptr)
             {
                 node_pointer* workArray{nullptr};
                 node_pointer* workIterator{nullptr};
-                const size_type count = 11;
+                const size_type count = BUCKET_POLICY::initial_capacity;
                 try
                 {
-                    workArray = arrayAllocator.allocate(count);
+                    workArray = allocate_buckets(count);
                 } catch (std::bad_alloc)
                 {
-                    return;
+                    return false;
+                }
+
+                if (!allocate_occupancy(count))
+                {
+                    arrayAllocator.deallocate(workArray, count);
+                    return false;
                 }
 
                 workIterator = workArray;
@@ -922,643 +2584,768 @@ namespace bice
 
                 arrayCapacity = count;
                 array = workArray;
+                rebuild_bloom();
             }
+            return true;
+        }
 
+        void grow_if_needed()
+        {
             auto loadFactor = load_factor();
-            if (loadFactor >= 3.0f)
+            if (loadFactor >= maxLoadFactor)
             {
                 reserve(arrayCapacity * 2);
             }
+        }
 
-            node_pointer workNode{nullptr};
-            node_pointer arrayNode{nullptr};
-            try
-            {
-                workNode = listAllocator.allocate(1);
-            } catch (std::bad_alloc)
-            {
-                return;
-            }
-
-            new(workNode) node_type{value_type(std::move(value)), nullptr, nullptr};
-
-            auto key = workNode->data.first;
-            auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-            arrayNode = array[hashValue];
-            if (arrayNode == nullptr)
-            {
-                array[hashValue] = workNode;
-            } else
+        void shrink_if_needed()
+        {
+            if (shrinkLoadFactor > 0.0f && arrayCapacity > BUCKET_POLICY::initial_capacity && load_factor() < shrinkLoadFactor)
             {
-                while (arrayNode->next != nullptr)
+                const auto targetCount = (size_type)std::ceil((double)tableSize / (double)(maxLoadFactor / 2.0f));
+                const size_type newCapacity = BUCKET_POLICY::capacity_for(std::max<size_type>(targetCount, BUCKET_POLICY::initial_capacity));
+                if (newCapacity < arrayCapacity)
                 {
-                    arrayNode = arrayNode->next;
+                    resize_array(newCapacity);
                 }
-
-                arrayNode->next = workNode;
-                workNode->previous = arrayNode;
             }
 
-            ++tableSize;
+            if (bloom_stale())
+            {
+                rebuild_bloom();
+            }
         }
 
-        template<typename... Args>
-        void emplace(Args... args)
+        template<typename ITERATOR>
+        void bulk_build(ITERATOR begin, const ITERATOR end, const size_type count)
         {
-            if (arrayCapacity == 0 && array == nullptr)
+            const auto bucketCount = (size_type)std::ceil((double)count / (double)maxLoadFactor);
+            resize_array(BUCKET_POLICY::capacity_for(std::max<size_type>(bucketCount, BUCKET_POLICY::initial_capacity)));
+            if (array == nullptr)
+            {
+                return;
+            }
+
+            if constexpr (requires(list_allocator_type& allocator_) { allocator_.reserve(count); })
             {
-                node_pointer* workArray{nullptr};
-                node_pointer* workIterator{nullptr};
-                const size_type count = 11;
                 try
                 {
-                    workArray = arrayAllocator.allocate(count);
+                    listAllocator.reserve(count);
                 } catch (std::bad_alloc)
                 {
                     return;
                 }
+            }
 
-                workIterator = workArray;
-                for(size_type idx = 0; idx < count; ++idx)
+            node_pointer workNode{nullptr};
+            for(auto iter = begin; iter != end; ++iter)
+            {
+                try
                 {
-                    *workIterator = nullptr;
-                    ++workIterator;
+                    workNode = allocate_node();
+                    new(workNode) node_type{value_type(*iter), nullptr, nullptr};
+                } catch (std::bad_alloc)
+                {
+                    clear();
+                    return;
+                } catch (...)
+                {
+                    deallocate_node(workNode);
+                    clear();
+                    return;
                 }
 
-                arrayCapacity = count;
-                array = workArray;
+                const size_type keyHash = hash_key(workNode->data.first);
+                workNode->set_hash(keyHash);
+                link_grouped(workNode, keyHash, BUCKET_POLICY::index(keyHash, arrayCapacity));
+                bloom_add(keyHash);
+                ++tableSize;
             }
+        }
 
-            auto loadFactor = load_factor();
-            if (loadFactor >= 3.0f)
+        void resize_array(const size_type newCapacity, const size_type threadCount = 1)
+        {
+#if defined(BICE_HASH_TABLE_STATS)
+            const auto rehashStart = std::chrono::steady_clock::now();
+            const node_pointer* previousArray = array;
+            replace_array(newCapacity, threadCount);
+            if (previousArray != nullptr && array != previousArray)
             {
-                reserve(arrayCapacity * 2);
+                ++counters.rehashCount;
+                counters.rehashNanoseconds += (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - rehashStart).count();
             }
+#else
+            replace_array(newCapacity, threadCount);
+#endif
+        }
 
-            node_pointer workNode{nullptr};
-            node_pointer arrayNode{nullptr};
+        void replace_array(const size_type newCapacity, const size_type threadCount)
+        {
+            if (oldArray != nullptr)
+            {
+                migrate_buckets(oldCapacity);
+            }
+
+            node_pointer* workArray{nullptr};
+            node_pointer* workIterator{nullptr};
             try
             {
-                workNode = listAllocator.allocate(1);
-                new(workNode) node_type{value_type(std::forward<Args>(args)...), nullptr, nullptr};
+                workArray = allocate_buckets(newCapacity);
             } catch (std::bad_alloc)
             {
                 return;
-            } catch (...)
+            }
+
+            if (!allocate_occupancy(newCapacity))
             {
-                (*workNode).~node_type();
-                listAllocator.deallocate(workNode, 1);
+                arrayAllocator.deallocate(workArray, newCapacity);
                 return;
             }
 
-            auto key = workNode->data.first;
-            auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-            arrayNode = array[hashValue];
-            if (arrayNode == nullptr)
+            workIterator = workArray;
+
+            for(size_type idx = 0; idx < newCapacity; ++idx)
             {
-                array[hashValue] = workNode;
-            } else
+                *workIterator = nullptr;
+                ++workIterator;
+            }
+
+            if (array == nullptr)
             {
-                while (arrayNode->next != nullptr)
-                {
-                    arrayNode = arrayNode->next;
-                }
+                array = workArray;
+                arrayCapacity = newCapacity;
+                rebuild_bloom();
+                return;
+            }
 
-                arrayNode->next = workNode;
-                workNode->previous = arrayNode;
+            const bool bloomStale = bloom_stale();
+            oldArray = array;
+            oldCapacity = arrayCapacity;
+            migrateIndex = 0;
+            array = workArray;
+            arrayCapacity = newCapacity;
+            if (!bloomStale)
+            {
+                begin_bloom_migration();
             }
 
-            ++tableSize;
+            const size_type workerCount = worker_count(threadCount, oldCapacity);
+            if (workerCount > 1)
+            {
+                migrate_parallel(workerCount);
+            } else
+            {
+                migrate_buckets(rehashStep > 0 ? rehashStep : oldCapacity);
+            }
+            if (bloomStale)
+            {
+                rebuild_bloom();
+            }
         }
 
-        iterator find(const key_type& key)
+        [[nodiscard]] static size_type worker_count(const size_type threadCount, const size_type work) noexcept
         {
-            if (tableSize > 0)
+            constexpr size_type grain = 4096;
+            size_type workers = threadCount;
+            if (workers == 0)
             {
-                auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-                if (hashValue <= arrayCapacity)
-                {
-                    return iterator(hashValue, const_cast<HashTable*>(this), array[hashValue]);
-                }
+                workers = std::max<size_type>(std::thread::hardware_concurrency(), 1);
             }
-            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+            return std::clamp<size_type>(work / grain, 1, workers);
         }
 
-        iterator find(const_reference value)
+        template<typename FUNCTION>
+        static void run_workers(const size_type workerCount, FUNCTION&& function)
         {
-            if (tableSize > 0)
+            std::vector<std::thread> workers;
+            size_type inlineFirst = workerCount;
+            for(size_type worker = 1; worker < workerCount; ++worker)
             {
-                const auto key = value.first;
-                auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-                if (hashValue < arrayCapacity && hashValue >= 0)
+                try
                 {
-                    node_pointer arrayNode = array[hashValue];
-                    while (arrayNode != nullptr)
-                    {
-                        if (arrayNode->data == value)
-                        {
-                            return iterator(hashValue, const_cast<HashTable*>(this), arrayNode);
-                        }
-                        arrayNode = arrayNode->next;
-                    }
+                    workers.emplace_back(std::ref(function), worker);
+                } catch (...)
+                {
+                    inlineFirst = worker;
+                    break;
                 }
             }
-            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+
+            function(0);
+            for(size_type worker = inlineFirst; worker < workerCount; ++worker)
+            {
+                function(worker);
+            }
+            for(auto& worker : workers)
+            {
+                worker.join();
+            }
         }
 
-        iterator find(const mapped_type& value)
+        inline void link_segment_atomic(node_pointer firstNode, node_pointer lastNode, const size_type index) noexcept
         {
-            if (tableSize > 0)
+            std::atomic_ref<node_pointer> head(array[index]);
+            node_pointer workNode = head.load(std::memory_order_acquire);
+            firstNode->previous = nullptr;
+            do
             {
-                node_pointer arrayNode{nullptr};
-                for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                {
-                    arrayNode = array[idx];
-                    while (arrayNode != nullptr)
-                    {
-                        if (arrayNode->data.second == value)
-                        {
-                            return iterator(idx, const_cast<HashTable*>(this), arrayNode);
-                        }
-                        arrayNode = arrayNode->next;
-                    }
-                }
+                lastNode->next = workNode;
+            } while (!head.compare_exchange_weak(workNode, firstNode, std::memory_order_acq_rel, std::memory_order_acquire));
+
+            if (workNode != nullptr)
+            {
+                workNode->previous = lastNode;
             }
+            std::atomic_ref<std::uint64_t>(occupancy[index >> 6]).fetch_or(std::uint64_t{1} << (index & 63), std::memory_order_relaxed);
+        }
 
-            return iterator(arrayCapacity, const_cast<HashTable*>(this), nullptr);
+        [[nodiscard]] inline size_type migrated_index(node_pointer migrateNode) noexcept
+        {
+            const size_type keyHash = node_hash(migrateNode);
+            bloom_set_atomic(bloomPending, bloomPendingBlocks, keyHash);
+            return BUCKET_POLICY::index(keyHash, arrayCapacity);
         }
 
-        void remove(const key_type& key)
+        void migrate_parallel(const size_type workerCount)
         {
-            if (tableSize > 0)
+            run_workers(workerCount, [this, workerCount](const size_type worker)
             {
-                auto hashValue = (size_type)hashFun(key) % arrayCapacity;
-                if (hashValue <= arrayCapacity)
+                const size_type first = oldCapacity * worker / workerCount;
+                const size_type last = oldCapacity * (worker + 1) / workerCount;
+                node_pointer segmentFirst{nullptr};
+                node_pointer segmentLast{nullptr};
+                node_pointer nextNode{nullptr};
+                size_type segmentIndex{0};
+                size_type nextIndex{0};
+                for(size_type idx = first; idx < last; ++idx)
                 {
-                    node_pointer arrayNode = array[hashValue];
-                    node_pointer deleteNode = arrayNode;
-                    while (arrayNode != nullptr)
+                    segmentFirst = oldArray[idx];
+                    oldArray[idx] = nullptr;
+                    if (segmentFirst != nullptr)
                     {
-                        arrayNode = arrayNode->next;
-                        (*deleteNode).~node_type();
-                        listAllocator.deallocate(arrayNode, 1);
-                        deleteNode = arrayNode;
-                        --tableSize;
+                        segmentIndex = migrated_index(segmentFirst);
+                    }
+                    while (segmentFirst != nullptr)
+                    {
+                        segmentLast = segmentFirst;
+                        nextNode = segmentFirst->next;
+                        while (nextNode != nullptr && (nextIndex = migrated_index(nextNode)) == segmentIndex)
+                        {
+                            segmentLast = nextNode;
+                            nextNode = nextNode->next;
+                        }
+                        link_segment_atomic(segmentFirst, segmentLast, segmentIndex);
+                        segmentFirst = nextNode;
+                        segmentIndex = nextIndex;
                     }
-
-                    array[hashValue] = nullptr;
                 }
-            }
+            });
+
+            free_old_array();
         }
 
-        void remove(iterator removeIterator)
+        template<typename K>
+        [[nodiscard]] node_pointer find_in_chain(node_pointer arrayNode, const size_type keyHash, const K& key) const
         {
-            node_pointer removeNode = removeIterator.get_node();
-            if (removeNode->previous == nullptr)
-            {
-                size_type hashValue = (size_type)hashFun(removeIterator.first) % arrayCapacity;
-                node_pointer nextNode = removeNode->next;
-                (*removeNode).~node_type();
-                listAllocator.deallocate(removeNode, 1);
-                --tableSize;
-                if (nextNode != nullptr)
-                {
-                    nextNode->previous = nullptr;
-                }
-                array[hashValue] = nextNode;
-            } else
+            size_type probes{0};
+            while (arrayNode != nullptr)
             {
-                node_pointer previousNode = removeNode->previous;
-                node_pointer nextNode = removeNode->next;
-                (*removeNode).~node_type();
-                listAllocator.deallocate(removeNode, 1);
-                --tableSize;
-                previousNode->next = nextNode;
-                if (nextNode != nullptr)
+                ++probes;
+                if (node_matches(arrayNode, keyHash, key))
                 {
-                    nextNode->previous = previousNode;
+                    count_lookup(probes);
+                    return arrayNode;
                 }
+                arrayNode = arrayNode->next;
             }
+            count_lookup(probes);
+            return nullptr;
         }
 
-        void remove(const mapped_type& value)
+        inline void link_front(node_pointer insertNode, const size_type index) noexcept
         {
-            iterator findIterator = find(value);
-            if (findIterator != end())
+            node_pointer workNode = array[index];
+            insertNode->previous = nullptr;
+            insertNode->next = workNode;
+            if (workNode != nullptr)
             {
-                node_pointer removeNode = findIterator.get_node();
-                if (removeNode->previous == nullptr)
-                {
-                    size_type hashValue = (size_type)hashFun(findIterator.first) % arrayCapacity;
-                    node_pointer nextNode = removeNode->next;
-                    (*removeNode).~node_type();
-                    listAllocator.deallocate(removeNode, 1);
-                    --tableSize;
-                    nextNode->previous = nullptr;
-                    array[hashValue] = nextNode;
-                } else
-                {
-                    node_pointer previousNode = removeNode->previous;
-                    node_pointer nextNode = removeNode->next;
-                    (*removeNode).~node_type();
-                    listAllocator.deallocate(removeNode, 1);
-                    --tableSize;
-                    previousNode->next = nextNode;
-                    if (nextNode != nullptr)
-                    {
-                        nextNode->previous = previousNode;
-                    }
-                }
+                workNode->previous = insertNode;
             }
+            array[index] = insertNode;
+            mark_occupied(index);
         }
 
-        void clear()
+        void link_grouped(node_pointer insertNode, const size_type keyHash, const size_type index) noexcept
         {
-            if (tableSize > 0)
+            node_pointer equalNode = array[index];
+            while (equalNode != nullptr && !node_matches(equalNode, keyHash, insertNode->data.first))
             {
-                node_pointer arrayNode{nullptr};
-                node_pointer deleteNode{nullptr};
+                equalNode = equalNode->next;
+            }
 
-                for(size_type idx = 0; idx < arrayCapacity; ++idx)
-                {
-                    arrayNode = array[idx];
-                    deleteNode = arrayNode;
-                    while (arrayNode != nullptr)
-                    {
-                        arrayNode = arrayNode->next;
-                        (*deleteNode).~node_type();
-                        listAllocator.deallocate(deleteNode, 1);
-                        deleteNode = arrayNode;
-                    }
-                }
-                tableSize = 0;
+            if (equalNode == nullptr)
+            {
+                link_front(insertNode, index);
+                return;
+            }
+
+            insertNode->previous = equalNode->previous;
+            insertNode->next = equalNode;
+            if (equalNode->previous == nullptr)
+            {
+                array[index] = insertNode;
+            } else
+            {
+                equalNode->previous->next = insertNode;
             }
+            equalNode->previous = insertNode;
         }
 
-        [[nodiscard]] inline bool operator == (const HashTable& other) const noexcept
+        void link_node(node_pointer workNode)
         {
-            bool equal = true;
+            const size_type keyHash = hash_key(workNode->data.first);
+            workNode->set_hash(keyHash);
+            migrate_key(keyHash);
+            link_grouped(workNode, keyHash, BUCKET_POLICY::index(keyHash, arrayCapacity));
+            bloom_add(keyHash);
+            ++tableSize;
+        }
 
-            if (tableSize == other.tableSize)
+        template<typename K>
+        [[nodiscard]] std::pair<node_pointer, node_pointer> equal_nodes(const K& key, size_type& index)
+        {
+            index = arrayCapacity;
+            if (tableSize == 0)
             {
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                return {nullptr, nullptr};
+            }
 
-                while (left != cend())
-                {
-                    if (*left != *right)
-                    {
-                        equal = false;
-                        break;
-                    }
-                    ++left;
-                    ++right;
-                }
-            } else
+            const size_type keyHash = hash_key(key);
+            if (!bloom_may_contain(keyHash))
             {
-                equal = false;
+                return {nullptr, nullptr};
             }
-            return equal;
+            migrate_key(keyHash);
+            index = BUCKET_POLICY::index(keyHash, arrayCapacity);
+            node_pointer firstNode = find_in_chain(array[index], keyHash, key);
+            node_pointer lastNode = firstNode;
+            while (lastNode != nullptr && lastNode->next != nullptr && node_matches(lastNode->next, keyHash, key))
+            {
+                lastNode = lastNode->next;
+            }
+            return {firstNode, lastNode};
         }
 
-        [[nodiscard]] inline bool operator != (const HashTable& other) const noexcept
+        template<typename K>
+        std::pair<iterator, iterator> equal_range_key(const K& key)
         {
-            bool equal = false;
-            if (tableSize == other.tableSize)
+            size_type index{0};
+            const auto [firstNode, lastNode] = equal_nodes(key, index);
+            if (firstNode == nullptr)
             {
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                return {end(), end()};
+            }
 
-                while (left != cend())
-                {
-                    if (*left != *right)
-                    {
-                        equal = true;
-                        break;
-                    }
-                    ++left;
-                    ++right;
-                }
-            } else
+            iterator last(index, this, lastNode);
+            ++last;
+            return {iterator(index, this, firstNode), last};
+        }
+
+        template<typename K>
+        view_type equal_view_key(const K& key)
+        {
+            size_type index{0};
+            const auto [firstNode, lastNode] = equal_nodes(key, index);
+            if (firstNode == nullptr)
             {
-                equal = true;
+                return view_type(view_end(), view_end());
             }
-            return equal;
+
+            view_iterator last(index, this, lastNode);
+            ++last;
+            return view_type(view_iterator(index, this, firstNode), last);
         }
 
-        [[nodiscard]] inline bool operator >= (const HashTable& other) const noexcept
+        template<typename K>
+        [[nodiscard]] size_type count_key(const K& key) const
         {
-            bool equal;
+            if (tableSize == 0)
+            {
+                return 0;
+            }
 
-            if (tableSize == other.tableSize)
+            const size_type keyHash = hash_key(key);
+            if (!bloom_may_contain(keyHash))
             {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                return 0;
+            }
+            node_pointer arrayNode = find_in_chain(array[BUCKET_POLICY::index(keyHash, arrayCapacity)], keyHash, key);
+            if (arrayNode == nullptr && oldArray != nullptr)
+            {
+                arrayNode = find_in_chain(oldArray[BUCKET_POLICY::index(keyHash, oldCapacity)], keyHash, key);
+            }
+
+            size_type count{0};
+            while (arrayNode != nullptr && node_matches(arrayNode, keyHash, key))
+            {
+                ++count;
+                arrayNode = arrayNode->next;
+            }
+            return count;
+        }
 
-                while (left != cend())
+        template<typename K>
+        iterator find_key(const K& key)
+        {
+            if (tableSize > 0)
+            {
+                const size_type keyHash = hash_key(key);
+                if (!bloom_may_contain(keyHash))
                 {
-                    if (*left != *right)
-                    {
-                        if (*left > *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
-                    }
-                    ++left;
-                    ++right;
+                    return end();
                 }
-            } else if (tableSize > other.tableSize)
-            {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                migrate_key(keyHash);
+                auto hashValue = BUCKET_POLICY::index(keyHash, arrayCapacity);
+                node_pointer arrayNode = find_in_chain(array[hashValue], keyHash, key);
+                if (arrayNode != nullptr)
+                {
+                    return iterator(hashValue, this, arrayNode);
+                }
+            }
+            return end();
+        }
 
-                while (right != other.cend())
+        template<typename K>
+        [[nodiscard]] bool contains_key(const K& key) const
+        {
+            if (tableSize > 0)
+            {
+                const size_type keyHash = hash_key(key);
+                if (!bloom_may_contain(keyHash))
                 {
-                    if (*left != *right)
-                    {
-                        if (*left > *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
-                    }
-                    ++left;
-                    ++right;
+                    return false;
                 }
+                if (find_in_chain(array[BUCKET_POLICY::index(keyHash, arrayCapacity)], keyHash, key) != nullptr)
+                {
+                    return true;
+                }
+                if (oldArray != nullptr)
+                {
+                    return find_in_chain(oldArray[BUCKET_POLICY::index(keyHash, oldCapacity)], keyHash, key) != nullptr;
+                }
+            }
+            return false;
+        }
 
-            } else if (tableSize < other.tableSize)
+        template<typename K>
+        size_type find_many_keys(std::span<const K> keys, std::span<pointer> results)
+        {
+            if (results.size() < keys.size())
             {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                throw std::out_of_range("Result span is smaller than key span");
+            }
 
-                while (left != cend())
+            if (tableSize == 0)
+            {
+                for(size_type idx = 0; idx < keys.size(); ++idx)
                 {
-                    if (*left != *right)
-                    {
-                        if (*left > *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
-                    }
-                    ++left;
-                    ++right;
+                    results[idx] = nullptr;
                 }
+                return 0;
             }
 
-            return equal;
-        }
+            finish_rehash();
 
-        [[nodiscard]] inline bool operator > (const HashTable& other) const noexcept
-        {
-            bool equal;
+            constexpr size_type batchSize = 32;
+            size_type bucketIndex[batchSize];
+            size_type keyHash[batchSize];
+            node_pointer bucketNode[batchSize];
+            size_type found{0};
 
-            if (tableSize == other.tableSize)
+            for(size_type first = 0; first < keys.size(); first += batchSize)
             {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                const size_type count = std::min<size_type>(batchSize, keys.size() - first);
 
-                while (left != cend())
+                for(size_type idx = 0; idx < count; ++idx)
                 {
-                    if (*left != *right)
+                    keyHash[idx] = hash_key(keys[first + idx]);
+                    bucketIndex[idx] = arrayCapacity;
+                    if (bloom_may_contain(keyHash[idx]))
                     {
-                        if (*left > *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
+                        bucketIndex[idx] = BUCKET_POLICY::index(keyHash[idx], arrayCapacity);
+                        prefetch_address(array + bucketIndex[idx]);
                     }
-                    ++left;
-                    ++right;
                 }
-            } else if (tableSize > other.tableSize)
-            {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
 
-                while (right != other.cend())
+                for(size_type idx = 0; idx < count; ++idx)
                 {
-                    if (*left != *right)
+                    bucketNode[idx] = bucketIndex[idx] < arrayCapacity ? array[bucketIndex[idx]] : nullptr;
+                    if (bucketNode[idx] != nullptr)
                     {
-                        if (*left > *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
+                        prefetch_address(bucketNode[idx]);
                     }
-                    ++left;
-                    ++right;
                 }
-            } else if (tableSize < other.tableSize)
-            {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
 
-                while (left != cend())
+                for(size_type idx = 0; idx < count; ++idx)
                 {
-                    if (*left != *right)
+                    node_pointer arrayNode = find_in_chain(bucketNode[idx], keyHash[idx], keys[first + idx]);
+                    if (arrayNode != nullptr)
                     {
-                        if (*left > *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
+                        results[first + idx] = &(arrayNode->data);
+                        ++found;
+                    } else
+                    {
+                        results[first + idx] = nullptr;
                     }
-                    ++left;
-                    ++right;
                 }
             }
 
-            return equal;
+            return found;
         }
 
-        [[nodiscard]] inline bool operator <= (const HashTable& other) const noexcept
+        template<typename K>
+        size_type remove_key(const K& key)
         {
-            bool equal;
+            size_type index{0};
+            const auto [firstNode, lastNode] = equal_nodes(key, index);
+            size_type count{0};
+            node_pointer arrayNode = firstNode;
+            node_pointer nextNode{nullptr};
+            while (arrayNode != nullptr)
+            {
+                nextNode = arrayNode == lastNode ? nullptr : arrayNode->next;
+                unlink_node(arrayNode, index);
+                ++count;
+                arrayNode = nextNode;
+            }
+            return count;
+        }
 
-            if (tableSize == other.tableSize)
+        template<typename... Args>
+        std::pair<iterator, bool> emplace_unique(const key_type& key, Args&&... args)
+        {
+            if (!ensure_array())
             {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                return {end(), false};
+            }
 
-                while (left != cend())
-                {
-                    if (*left != *right)
-                    {
-                        if (*left < *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
-                    }
-                    ++left;
-                    ++right;
-                }
+            const size_type keyHash = hash_key(key);
+            migrate_key(keyHash);
+            auto hashValue = BUCKET_POLICY::index(keyHash, arrayCapacity);
+            node_pointer workNode = find_in_chain(array[hashValue], keyHash, key);
+            if (workNode != nullptr)
+            {
+                return {iterator(hashValue, this, workNode), false};
+            }
 
-            } else if (tableSize > other.tableSize)
+            const size_type oldArrayCapacity = arrayCapacity;
+            grow_if_needed();
+            if (arrayCapacity != oldArrayCapacity)
             {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                migrate_key(keyHash);
+                hashValue = BUCKET_POLICY::index(keyHash, arrayCapacity);
+            }
 
-                while (right != other.cend())
-                {
-                    if (*left != *right)
-                    {
-                        if (*left < *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
-                    }
-                    ++left;
-                    ++right;
-                }
+            try
+            {
+                workNode = allocate_node();
+                new(workNode) node_type{value_type(std::forward<Args>(args)...), nullptr, nullptr};
+            } catch (std::bad_alloc)
+            {
+                return {end(), false};
+            } catch (...)
+            {
+                deallocate_node(workNode);
+                return {end(), false};
+            }
 
-            } else if (tableSize < other.tableSize)
+            workNode->set_hash(keyHash);
+            link_front(workNode, hashValue);
+            bloom_add(keyHash);
+            ++tableSize;
+
+            return {iterator(hashValue, this, workNode), true};
+        }
+
+        [[nodiscard]] bool copy_pending_nodes(const HashTable& other)
+        {
+            if (other.oldArray == nullptr)
             {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                return true;
+            }
 
-                while (left != cend())
+            node_pointer otherArrayNode{nullptr};
+            node_pointer workNode{nullptr};
+            for(size_type idx = other.migrateIndex; idx < other.oldCapacity; ++idx)
+            {
+                for(otherArrayNode = other.oldArray[idx]; otherArrayNode != nullptr; otherArrayNode = otherArrayNode->next)
                 {
-                    if (*left != *right)
+                    try
                     {
-                        if (*left < *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
+                        workNode = allocate_node();
+                        new(workNode) node_type{value_type(otherArrayNode->data), nullptr, nullptr};
+                    } catch (std::bad_alloc)
+                    {
+                        return false;
+                    } catch (...)
+                    {
+                        deallocate_node(workNode);
+                        return false;
                     }
-                    ++left;
-                    ++right;
+
+                    const size_type keyHash = node_hash(otherArrayNode);
+                    workNode->set_hash(keyHash);
+                    link_front(workNode, BUCKET_POLICY::index(keyHash, arrayCapacity));
                 }
             }
+            return true;
+        }
 
-            return equal;
+        void migrate_bucket(const size_type index) noexcept
+        {
+            node_pointer arrayNode = oldArray[index];
+            node_pointer insertNode{nullptr};
+            size_type keyHash{0};
+            oldArray[index] = nullptr;
+
+            while (arrayNode != nullptr)
+            {
+                insertNode = arrayNode;
+                arrayNode = arrayNode->next;
+                keyHash = node_hash(insertNode);
+                bloom_set(bloomPending, bloomPendingBlocks, keyHash);
+                link_front(insertNode, BUCKET_POLICY::index(keyHash, arrayCapacity));
+            }
         }
 
-        [[nodiscard]] inline bool operator < (const HashTable& other) const noexcept
+        void migrate_buckets(size_type count) noexcept
         {
-            bool equal;
+            while (count > 0 && migrateIndex < oldCapacity)
+            {
+                migrate_bucket(migrateIndex);
+                ++migrateIndex;
+                --count;
+            }
 
-            if (tableSize == other.tableSize)
+            if (migrateIndex == oldCapacity)
             {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                free_old_array();
+            }
+        }
 
-                while (left != cend())
+        void migrate_key(const size_type keyHash) noexcept
+        {
+            if (oldArray != nullptr)
+            {
+                timed_migration([this, keyHash]()
                 {
-                    if (*left != *right)
+                    migrate_buckets(rehashStep);
+                    if (oldArray != nullptr)
                     {
-                        if (*left < *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
+                        migrate_bucket(BUCKET_POLICY::index(keyHash, oldCapacity));
                     }
-                    ++left;
-                    ++right;
+                });
+            }
+        }
+
+        template<typename FUNCTION>
+        inline void timed_migration(FUNCTION&& function) noexcept
+        {
+#if defined(BICE_HASH_TABLE_STATS)
+            const auto migrateStart = std::chrono::steady_clock::now();
+            function();
+            counters.rehashNanoseconds += (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - migrateStart).count();
+#else
+            function();
+#endif
+        }
+
+        void free_old_array() noexcept
+        {
+            if (oldArray != nullptr)
+            {
+                arrayAllocator.deallocate(oldArray, oldCapacity);
+            }
+            oldArray = nullptr;
+            oldCapacity = 0;
+            migrateIndex = 0;
+            finish_bloom_migration();
+        }
+
+        void unlink_node(node_pointer removeNode, const size_type index) noexcept
+        {
+            node_pointer previousNode = removeNode->previous;
+            node_pointer nextNode = removeNode->next;
+
+            if (previousNode == nullptr)
+            {
+                array[index] = nextNode;
+                if (nextNode == nullptr)
+                {
+                    mark_empty(index);
                 }
-            } else if (tableSize > other.tableSize)
+            } else
             {
-                equal = false;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
+                previousNode->next = nextNode;
+            }
+
+            if (nextNode != nullptr)
+            {
+                nextNode->previous = previousNode;
+            }
+
+            (*removeNode).~node_type();
+            deallocate_node(removeNode);
+            --tableSize;
+            ++bloomRemoved;
+        }
+
+        void destroy_chains(node_pointer* bucketArray, const size_type capacity, const bool deallocate) noexcept
+        {
+            node_pointer arrayNode{nullptr};
+            node_pointer deleteNode{nullptr};
 
-                while (right != other.cend())
+            for(size_type idx = 0; idx < capacity; ++idx)
+            {
+                arrayNode = bucketArray[idx];
+                while (arrayNode != nullptr)
                 {
-                    if (*left != *right)
+                    deleteNode = arrayNode;
+                    arrayNode = arrayNode->next;
+                    (*deleteNode).~node_type();
+                    if (deallocate)
                     {
-                        if (*left < *right)
-                        {
-                            equal = true;
-                            break;
-                        } else
-                        {
-                            break;
-                        }
+                        deallocate_node(deleteNode);
                     }
-                    ++left;
-                    ++right;
                 }
+            }
+        }
 
-            } else if (tableSize < other.tableSize)
+        void free_nodes() noexcept
+        {
+            if constexpr (requires(list_allocator_type& allocator_) { allocator_.release(); })
             {
-                equal = true;
-                const_iterator left = cbegin();
-                const_iterator right = other.cbegin();
-
-                while (left != cend())
+                if constexpr (!std::is_trivially_destructible_v<node_type>)
                 {
-                    if (*left != *right)
+                    destroy_chains(array, arrayCapacity, false);
+                    if (oldArray != nullptr)
                     {
-                        if (*left < *right)
-                        {
-                            break;
-                        } else
-                        {
-                            equal = false;
-                            break;
-                        }
+                        destroy_chains(oldArray, oldCapacity, false);
                     }
-                    ++left;
-                    ++right;
+                }
+#if defined(BICE_HASH_TABLE_STATS)
+                counters.nodeDeallocations += tableSize;
+#endif
+                listAllocator.release();
+            } else
+            {
+                destroy_chains(array, arrayCapacity, true);
+                if (oldArray != nullptr)
+                {
+                    destroy_chains(oldArray, oldCapacity, true);
                 }
             }
-
-            return equal;
         }
-        
-    private:
-
-        array_allocator_type arrayAllocator;
-        list_allocator_type listAllocator;
-        hasher hashFun;
-        key_equal keyEqual;
-        size_type tableSize;
-        size_type arrayCapacity;
-        node_pointer* array;
     };
 
 }
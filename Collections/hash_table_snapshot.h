@@ -0,0 +1,437 @@
+#ifndef INC_3DGAME_HASH_TABLE_SNAPSHOT_H
+#define INC_3DGAME_HASH_TABLE_SNAPSHOT_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <utility>
+#include <functional>
+#include <span>
+#include <vector>
+#include <type_traits>
+#include "hash_table.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bice
+{
+
+    struct HashTableSnapshotHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t keySize;
+        std::uint32_t valueSize;
+        std::uint32_t entrySize;
+        std::uint64_t bucketCount;
+        std::uint64_t entryCount;
+        std::uint64_t bucketOffset;
+        std::uint64_t entryOffset;
+    };
+
+    template<typename KEY, typename VALUE>
+    struct HashTableSnapshotEntry
+    {
+        KEY key;
+        VALUE value;
+    };
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename BUCKET_POLICY = PowerOfTwoBucketPolicy
+    >
+    class HashTableSnapshot
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using size_type                                = std::uint64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using bucket_policy                            = BUCKET_POLICY;
+        using entry_type                               = HashTableSnapshotEntry<KEY, VALUE>;
+        using header_type                              = HashTableSnapshotHeader;
+
+        static_assert(std::is_trivially_copyable_v<KEY>, "Snapshot keys must be trivially copyable");
+        static_assert(std::is_trivially_copyable_v<VALUE>, "Snapshot values must be trivially copyable");
+
+        static constexpr std::uint32_t version         = 1;
+        static constexpr size_type alignment           = 64;
+
+        HashTableSnapshot(hasher hasher_ = HASH(), key_equal keyEqual_ = KEY_EQUAL()) noexcept :
+        hashFun(hasher_),
+        keyEqual(keyEqual_),
+        data{}, dataSize{},
+        bucketOffsets{}, entries{},
+        bucketCount{}, entryCount{},
+        mappedData{}
+#if defined(_WIN32)
+        , fileHandle(INVALID_HANDLE_VALUE), mappingHandle{}
+#endif
+        {}
+
+        HashTableSnapshot(const HashTableSnapshot&) = delete;
+        HashTableSnapshot& operator = (const HashTableSnapshot&) = delete;
+
+        HashTableSnapshot(HashTableSnapshot&& other) noexcept :
+        hashFun(std::move(other.hashFun)),
+        keyEqual(std::move(other.keyEqual)),
+        data(other.data), dataSize(other.dataSize),
+        bucketOffsets(other.bucketOffsets), entries(other.entries),
+        bucketCount(other.bucketCount), entryCount(other.entryCount),
+        mappedData(other.mappedData)
+#if defined(_WIN32)
+        , fileHandle(other.fileHandle), mappingHandle(other.mappingHandle)
+#endif
+        {
+            other.forget();
+        }
+
+        HashTableSnapshot& operator = (HashTableSnapshot&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                hashFun = std::move(other.hashFun);
+                keyEqual = std::move(other.keyEqual);
+                data = other.data;
+                dataSize = other.dataSize;
+                bucketOffsets = other.bucketOffsets;
+                entries = other.entries;
+                bucketCount = other.bucketCount;
+                entryCount = other.entryCount;
+                mappedData = other.mappedData;
+#if defined(_WIN32)
+                fileHandle = other.fileHandle;
+                mappingHandle = other.mappingHandle;
+#endif
+                other.forget();
+            }
+            return *this;
+        }
+
+        virtual ~HashTableSnapshot()
+        {
+            close();
+        }
+
+        template<typename HASH_TABLE>
+        static bool save(const HASH_TABLE& table, const std::string& path, const hasher& hasher_ = HASH())
+        {
+            static_assert(std::is_same_v<typename HASH_TABLE::key_type, KEY>, "Snapshot key type mismatch");
+            static_assert(std::is_same_v<typename HASH_TABLE::mapped_type, VALUE>, "Snapshot value type mismatch");
+            static_assert(std::is_same_v<typename HASH_TABLE::hasher, HASH>, "Snapshot hasher mismatch");
+            static_assert(std::is_same_v<typename HASH_TABLE::bucket_policy, BUCKET_POLICY>, "Snapshot bucket policy mismatch");
+
+            const size_type tableCapacity = table.capacity() > 0 ? table.capacity() : 1;
+
+            std::vector<std::uint64_t> offsets(tableCapacity + 1, 0);
+            std::vector<size_type> indexes;
+            std::vector<typename HASH_TABLE::const_view_iterator> sources;
+            for(auto iter = table.cview_begin(); iter != table.cview_end(); ++iter)
+            {
+                const size_type index = BUCKET_POLICY::index((size_type)hasher_(iter.key()), tableCapacity);
+                ++offsets[index + 1];
+                indexes.push_back(index);
+                sources.push_back(iter);
+            }
+            for(size_type idx = 0; idx < tableCapacity; ++idx)
+            {
+                offsets[idx + 1] += offsets[idx];
+            }
+
+            std::vector<typename HASH_TABLE::const_view_iterator> ordered(sources.size());
+            {
+                std::vector<std::uint64_t> fill(offsets.begin(), offsets.end() - 1);
+                for(size_type idx = 0; idx < sources.size(); ++idx)
+                {
+                    ordered[fill[indexes[idx]]++] = sources[idx];
+                }
+            }
+
+            header_type header{};
+            std::memcpy(header.magic, "BICEHTS", 8);
+            header.version = version;
+            header.keySize = sizeof(KEY);
+            header.valueSize = sizeof(VALUE);
+            header.entrySize = sizeof(entry_type);
+            header.bucketCount = tableCapacity;
+            header.entryCount = offsets[tableCapacity];
+            header.bucketOffset = align_up(sizeof(header_type));
+            header.entryOffset = align_up(header.bucketOffset + (tableCapacity + 1) * sizeof(std::uint64_t));
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+
+            const char padding[alignment]{};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header_type));
+            file.write(padding, (std::streamsize)(header.bucketOffset - sizeof(header_type)));
+            file.write(reinterpret_cast<const char*>(offsets.data()), (std::streamsize)(offsets.size() * sizeof(std::uint64_t)));
+            file.write(padding, (std::streamsize)(header.entryOffset - header.bucketOffset - offsets.size() * sizeof(std::uint64_t)));
+
+            alignas(entry_type) unsigned char entry[sizeof(entry_type)];
+            for(const auto& iter : ordered)
+            {
+                std::memset(entry, 0, sizeof(entry_type));
+                new(entry) entry_type{iter.key(), iter.value()};
+                file.write(reinterpret_cast<const char*>(entry), sizeof(entry_type));
+            }
+
+            file.flush();
+            return (bool)file;
+        }
+
+        bool open(const std::string& path)
+        {
+            close();
+#if defined(_WIN32)
+            fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (fileHandle == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+            {
+                close();
+                return false;
+            }
+
+            mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle == nullptr)
+            {
+                close();
+                return false;
+            }
+
+            void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+            if (view == nullptr)
+            {
+                close();
+                return false;
+            }
+
+            mappedData = view;
+            dataSize = (size_type)fileSize.QuadPart;
+#else
+            const int descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor < 0)
+            {
+                return false;
+            }
+
+            struct stat fileStat{};
+            if (::fstat(descriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+            {
+                ::close(descriptor);
+                return false;
+            }
+
+            void* view = ::mmap(nullptr, (std::size_t)fileStat.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+            ::close(descriptor);
+            if (view == MAP_FAILED)
+            {
+                return false;
+            }
+
+            mappedData = view;
+            dataSize = (size_type)fileStat.st_size;
+#endif
+            if (!attach(mappedData, dataSize))
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        bool attach(const void* data_, const size_type dataSize_) noexcept
+        {
+            if (data_ == nullptr || dataSize_ < sizeof(header_type))
+            {
+                return false;
+            }
+
+            const auto bytes = static_cast<const unsigned char*>(data_);
+            header_type header;
+            std::memcpy(&header, bytes, sizeof(header_type));
+
+            if (std::memcmp(header.magic, "BICEHTS", 8) != 0 || header.version != version ||
+                header.keySize != sizeof(KEY) || header.valueSize != sizeof(VALUE) ||
+                header.entrySize != sizeof(entry_type) || header.bucketCount == 0 ||
+                header.bucketOffset % alignof(std::uint64_t) != 0 || header.entryOffset % alignof(entry_type) != 0 ||
+                header.bucketOffset > dataSize_ || header.entryOffset > dataSize_ ||
+                header.bucketCount >= (dataSize_ - header.bucketOffset) / sizeof(std::uint64_t) ||
+                header.entryCount > (dataSize_ - header.entryOffset) / sizeof(entry_type))
+            {
+                return false;
+            }
+
+            const auto offsets = reinterpret_cast<const std::uint64_t*>(bytes + header.bucketOffset);
+            if (offsets[0] != 0 || offsets[header.bucketCount] != header.entryCount)
+            {
+                return false;
+            }
+            for(size_type idx = 0; idx < header.bucketCount; ++idx)
+            {
+                if (offsets[idx] > offsets[idx + 1])
+                {
+                    return false;
+                }
+            }
+
+            const auto firstEntries = reinterpret_cast<const entry_type*>(bytes + header.entryOffset);
+            if (header.entryCount > 0)
+            {
+                const size_type index = BUCKET_POLICY::index((size_type)hashFun(firstEntries[0].key), header.bucketCount);
+                if (offsets[index] != 0 || offsets[index + 1] == 0)
+                {
+                    return false;
+                }
+            }
+
+            data = bytes;
+            dataSize = dataSize_;
+            bucketOffsets = offsets;
+            entries = firstEntries;
+            bucketCount = header.bucketCount;
+            entryCount = header.entryCount;
+            return true;
+        }
+
+        void close() noexcept
+        {
+#if defined(_WIN32)
+            if (mappedData != nullptr)
+            {
+                UnmapViewOfFile(mappedData);
+            }
+            if (mappingHandle != nullptr)
+            {
+                CloseHandle(mappingHandle);
+            }
+            if (fileHandle != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(fileHandle);
+            }
+#else
+            if (mappedData != nullptr)
+            {
+                ::munmap(mappedData, (std::size_t)dataSize);
+            }
+#endif
+            forget();
+        }
+
+        [[nodiscard]] inline bool is_open() const noexcept
+        {
+            return data != nullptr;
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return entryCount;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return entryCount == 0;
+        }
+
+        [[nodiscard]] inline size_type bucket_count() const noexcept
+        {
+            return bucketCount;
+        }
+
+        [[nodiscard]] inline std::span<const entry_type> entry_span() const noexcept
+        {
+            return std::span<const entry_type>(entries, entryCount);
+        }
+
+        [[nodiscard]] const mapped_type* find(const key_type& key) const
+        {
+            if (entryCount == 0)
+            {
+                return nullptr;
+            }
+
+            const size_type index = BUCKET_POLICY::index((size_type)hashFun(key), bucketCount);
+            const size_type last = bucketOffsets[index + 1];
+            for(size_type idx = bucketOffsets[index]; idx < last; ++idx)
+            {
+                if (keyEqual(entries[idx].key, key))
+                {
+                    return &(entries[idx].value);
+                }
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+    private:
+
+        hasher hashFun;
+        key_equal keyEqual;
+        const unsigned char* data;
+        size_type dataSize;
+        const std::uint64_t* bucketOffsets;
+        const entry_type* entries;
+        size_type bucketCount;
+        size_type entryCount;
+        void* mappedData;
+#if defined(_WIN32)
+        HANDLE fileHandle;
+        HANDLE mappingHandle;
+#endif
+
+        [[nodiscard]] static inline constexpr size_type align_up(const size_type offset) noexcept
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        void forget() noexcept
+        {
+            data = nullptr;
+            dataSize = 0;
+            bucketOffsets = nullptr;
+            entries = nullptr;
+            bucketCount = 0;
+            entryCount = 0;
+            mappedData = nullptr;
+#if defined(_WIN32)
+            fileHandle = INVALID_HANDLE_VALUE;
+            mappingHandle = nullptr;
+#endif
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_HASH_TABLE_SNAPSHOT_H
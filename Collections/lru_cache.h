@@ -0,0 +1,822 @@
+#ifndef INC_3DGAME_LRU_CACHE_H
+#define INC_3DGAME_LRU_CACHE_H
+
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <bit>
+#include <type_traits>
+#include "hash_table.h"
+#include "node_pool_allocator.h"
+
+namespace bice
+{
+
+    template<typename KEY, typename VALUE>
+    struct CacheWeight
+    {
+        [[nodiscard]] inline std::uint64_t operator () (const KEY&, const VALUE&) const noexcept
+        {
+            return sizeof(KEY) + sizeof(VALUE);
+        }
+    };
+
+    template<typename TYPE>
+    struct CacheNode
+    {
+        TYPE data;
+        CacheNode* chain;
+        CacheNode* previous;
+        CacheNode* next;
+        std::uint64_t hash;
+        std::uint64_t weight;
+        std::atomic<std::uint8_t> referenced;
+    };
+
+    template<typename NODE, typename ARRAY_ALLOCATOR, typename BUCKET_POLICY>
+    class CacheBuckets
+    {
+    public:
+
+        using size_type                                = std::uint64_t;
+        using node_pointer                             = NODE*;
+        using array_allocator_type                     = typename std::allocator_traits<ARRAY_ALLOCATOR>::template rebind_alloc<node_pointer>;
+
+        CacheBuckets() noexcept : arrayAllocator(), array{}, arrayCapacity{} {}
+
+        CacheBuckets(const CacheBuckets&) = delete;
+        CacheBuckets& operator = (const CacheBuckets&) = delete;
+
+        ~CacheBuckets()
+        {
+            release();
+        }
+
+        [[nodiscard]] inline size_type capacity() const noexcept
+        {
+            return arrayCapacity;
+        }
+
+        bool reserve(const size_type count)
+        {
+            const size_type newCapacity = BUCKET_POLICY::capacity_for(count > 0 ? count : 1);
+            if (newCapacity <= arrayCapacity)
+            {
+                return true;
+            }
+
+            node_pointer* workArray{nullptr};
+            try
+            {
+                workArray = arrayAllocator.allocate(newCapacity);
+            } catch (std::bad_alloc)
+            {
+                return false;
+            }
+
+            for(size_type idx = 0; idx < newCapacity; ++idx)
+            {
+                workArray[idx] = nullptr;
+            }
+
+            node_pointer node{nullptr};
+            node_pointer insertNode{nullptr};
+            for(size_type idx = 0; idx < arrayCapacity; ++idx)
+            {
+                node = array[idx];
+                while (node != nullptr)
+                {
+                    insertNode = node;
+                    node = node->chain;
+                    const size_type index = BUCKET_POLICY::index(insertNode->hash, newCapacity);
+                    insertNode->chain = workArray[index];
+                    workArray[index] = insertNode;
+                }
+            }
+
+            release();
+            array = workArray;
+            arrayCapacity = newCapacity;
+            return true;
+        }
+
+        template<typename KEY, typename KEY_EQUAL>
+        [[nodiscard]] node_pointer find(const size_type keyHash, const KEY& key, const KEY_EQUAL& keyEqual) const
+        {
+            if (arrayCapacity == 0)
+            {
+                return nullptr;
+            }
+
+            node_pointer node = array[BUCKET_POLICY::index(keyHash, arrayCapacity)];
+            while (node != nullptr)
+            {
+                if (node->hash == keyHash && keyEqual(node->data.first, key))
+                {
+                    return node;
+                }
+                node = node->chain;
+            }
+            return nullptr;
+        }
+
+        inline void link(node_pointer node) noexcept
+        {
+            const size_type index = BUCKET_POLICY::index(node->hash, arrayCapacity);
+            node->chain = array[index];
+            array[index] = node;
+        }
+
+        void unlink(node_pointer node) noexcept
+        {
+            node_pointer* link = array + BUCKET_POLICY::index(node->hash, arrayCapacity);
+            while (*link != node)
+            {
+                link = &((*link)->chain);
+            }
+            *link = node->chain;
+        }
+
+        void clear() noexcept
+        {
+            for(size_type idx = 0; idx < arrayCapacity; ++idx)
+            {
+                array[idx] = nullptr;
+            }
+        }
+
+    private:
+
+        array_allocator_type arrayAllocator;
+        node_pointer* array;
+        size_type arrayCapacity;
+
+        void release() noexcept
+        {
+            if (array != nullptr)
+            {
+                arrayAllocator.deallocate(array, arrayCapacity);
+                array = nullptr;
+                arrayCapacity = 0;
+            }
+        }
+    };
+
+    // LruCache is not thread-safe: get() reorders the list and returns a pointer into the cache.
+    // Guard it with an external lock, or use ClockCache for concurrent access.
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename WEIGHT = CacheWeight<KEY, VALUE>,
+            typename ARRAY_ALLOCATOR = std::allocator<CacheNode<std::pair<KEY, VALUE>>*>,
+            typename LIST_ALLOCATOR = NodePoolAllocator<CacheNode<std::pair<KEY, VALUE>>>,
+            typename BUCKET_POLICY = PowerOfTwoBucketPolicy
+    >
+    class LruCache
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using size_type                                = std::uint64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using weigher                                  = WEIGHT;
+        using bucket_policy                            = BUCKET_POLICY;
+        using node_type                                = CacheNode<value_type>;
+        using node_pointer                             = node_type*;
+        using list_allocator_type                      = typename std::allocator_traits<LIST_ALLOCATOR>::template rebind_alloc<node_type>;
+
+        explicit LruCache(
+                const size_type capacity_,
+                const size_type byteLimit_ = std::numeric_limits<size_type>::max(),
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                weigher weigher_ = WEIGHT()
+                ) :
+                listAllocator(),
+                buckets(),
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                weightFun(weigher_),
+                head{}, tail{},
+                cacheSize{}, cacheBytes{},
+                capacityLimit(capacity_),
+                byteLimit(byteLimit_)
+                {
+                    buckets.reserve(std::min<size_type>(capacityLimit, BUCKET_POLICY::initial_capacity));
+                }
+
+        LruCache(const LruCache&) = delete;
+        LruCache& operator = (const LruCache&) = delete;
+        LruCache(LruCache&&) = delete;
+        LruCache& operator = (LruCache&&) = delete;
+
+        virtual ~LruCache()
+        {
+            free_nodes();
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return cacheSize;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return cacheSize == 0;
+        }
+
+        [[nodiscard]] inline size_type bytes() const noexcept
+        {
+            return cacheBytes;
+        }
+
+        [[nodiscard]] inline size_type capacity() const noexcept
+        {
+            return capacityLimit;
+        }
+
+        [[nodiscard]] inline size_type byte_limit() const noexcept
+        {
+            return byteLimit;
+        }
+
+        void set_limits(const size_type capacity_, const size_type byteLimit_ = std::numeric_limits<size_type>::max())
+        {
+            capacityLimit = capacity_;
+            byteLimit = byteLimit_;
+            evict(0, 0);
+        }
+
+        [[nodiscard]] mapped_type* get(const key_type& key)
+        {
+            node_pointer node = buckets.find((size_type)hashFun(key), key, keyEqual);
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+
+            move_to_front(node);
+            return &(node->data.second);
+        }
+
+        [[nodiscard]] const mapped_type* peek(const key_type& key) const
+        {
+            node_pointer node = buckets.find((size_type)hashFun(key), key, keyEqual);
+            return node == nullptr ? nullptr : &(node->data.second);
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return buckets.find((size_type)hashFun(key), key, keyEqual) != nullptr;
+        }
+
+        template<typename MAPPED>
+        bool put(const key_type& key, MAPPED&& value)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const size_type weight = (size_type)weightFun(key, value);
+            node_pointer node = buckets.find(keyHash, key, keyEqual);
+            if (weight > byteLimit || capacityLimit == 0)
+            {
+                if (node != nullptr)
+                {
+                    remove_node(node);
+                }
+                return false;
+            }
+
+            if (node != nullptr)
+            {
+                node->data.second = std::forward<MAPPED>(value);
+                cacheBytes = cacheBytes - node->weight + weight;
+                node->weight = weight;
+                move_to_front(node);
+                evict(0, 0);
+                return true;
+            }
+
+            evict(1, weight);
+            if (cacheSize + 1 > buckets.capacity())
+            {
+                buckets.reserve(buckets.capacity() * 2);
+            }
+
+            try
+            {
+                node = listAllocator.allocate(1);
+                new(node) node_type{value_type(key, std::forward<MAPPED>(value)), nullptr, nullptr, nullptr, keyHash, weight, 0};
+            } catch (std::bad_alloc)
+            {
+                return false;
+            } catch (...)
+            {
+                listAllocator.deallocate(node, 1);
+                throw;
+            }
+
+            buckets.link(node);
+            link_front(node);
+            ++cacheSize;
+            cacheBytes += weight;
+            return true;
+        }
+
+        bool erase(const key_type& key)
+        {
+            node_pointer node = buckets.find((size_type)hashFun(key), key, keyEqual);
+            if (node == nullptr)
+            {
+                return false;
+            }
+
+            remove_node(node);
+            return true;
+        }
+
+        void clear()
+        {
+            free_nodes();
+            buckets.clear();
+            head = nullptr;
+            tail = nullptr;
+            cacheSize = 0;
+            cacheBytes = 0;
+        }
+
+        template<typename FUNCTION>
+        void for_each(FUNCTION&& function) const
+        {
+            for(node_pointer node = head; node != nullptr; node = node->next)
+            {
+                function(static_cast<const value_type&>(node->data));
+            }
+        }
+
+    private:
+
+        list_allocator_type listAllocator;
+        CacheBuckets<node_type, ARRAY_ALLOCATOR, BUCKET_POLICY> buckets;
+        hasher hashFun;
+        key_equal keyEqual;
+        weigher weightFun;
+        node_pointer head;
+        node_pointer tail;
+        size_type cacheSize;
+        size_type cacheBytes;
+        size_type capacityLimit;
+        size_type byteLimit;
+
+        inline void link_front(node_pointer node) noexcept
+        {
+            node->previous = nullptr;
+            node->next = head;
+            if (head != nullptr)
+            {
+                head->previous = node;
+            } else
+            {
+                tail = node;
+            }
+            head = node;
+        }
+
+        inline void unlink_list(node_pointer node) noexcept
+        {
+            if (node->previous != nullptr)
+            {
+                node->previous->next = node->next;
+            } else
+            {
+                head = node->next;
+            }
+
+            if (node->next != nullptr)
+            {
+                node->next->previous = node->previous;
+            } else
+            {
+                tail = node->previous;
+            }
+        }
+
+        inline void move_to_front(node_pointer node) noexcept
+        {
+            if (node != head)
+            {
+                unlink_list(node);
+                link_front(node);
+            }
+        }
+
+        void remove_node(node_pointer node) noexcept
+        {
+            buckets.unlink(node);
+            unlink_list(node);
+            --cacheSize;
+            cacheBytes -= node->weight;
+            (*node).~node_type();
+            listAllocator.deallocate(node, 1);
+        }
+
+        void evict(const size_type extraCount, const size_type extraBytes) noexcept
+        {
+            while (tail != nullptr && (cacheSize + extraCount > capacityLimit || cacheBytes + extraBytes > byteLimit))
+            {
+                remove_node(tail);
+            }
+        }
+
+        void free_nodes() noexcept
+        {
+            node_pointer node = head;
+            node_pointer deleteNode{nullptr};
+            while (node != nullptr)
+            {
+                deleteNode = node;
+                node = node->next;
+                (*deleteNode).~node_type();
+                listAllocator.deallocate(deleteNode, 1);
+            }
+        }
+    };
+
+    template<
+            typename KEY,
+            typename VALUE,
+            typename HASH = std::hash<KEY>,
+            typename KEY_EQUAL = std::equal_to<KEY>,
+            typename WEIGHT = CacheWeight<KEY, VALUE>,
+            typename ARRAY_ALLOCATOR = std::allocator<CacheNode<std::pair<KEY, VALUE>>*>,
+            typename LIST_ALLOCATOR = NodePoolAllocator<CacheNode<std::pair<KEY, VALUE>>>,
+            typename BUCKET_POLICY = PowerOfTwoBucketPolicy
+    >
+    class ClockCache
+    {
+    public:
+
+        using key_type                                 = KEY;
+        using mapped_type                              = VALUE;
+        using value_type                               = std::pair<KEY, VALUE>;
+        using size_type                                = std::uint64_t;
+        using hasher                                   = HASH;
+        using key_equal                                = KEY_EQUAL;
+        using weigher                                  = WEIGHT;
+        using bucket_policy                            = BUCKET_POLICY;
+        using node_type                                = CacheNode<value_type>;
+        using node_pointer                             = node_type*;
+        using list_allocator_type                      = typename std::allocator_traits<LIST_ALLOCATOR>::template rebind_alloc<node_type>;
+        using shared_mutex_type                        = std::shared_mutex;
+        using shared_lock_type                         = std::shared_lock<std::shared_mutex>;
+        using unique_lock_type                         = std::unique_lock<std::shared_mutex>;
+
+        explicit ClockCache(
+                const size_type capacity_,
+                const size_type byteLimit_ = std::numeric_limits<size_type>::max(),
+                const size_type shardCount_ = 16,
+                hasher hasher_ = HASH(),
+                key_equal keyEqual_ = KEY_EQUAL(),
+                weigher weigher_ = WEIGHT()
+                ) :
+                hashFun(hasher_),
+                keyEqual(keyEqual_),
+                weightFun(weigher_),
+                cacheSize{}, cacheBytes{},
+                capacityLimit(capacity_),
+                byteLimit(byteLimit_),
+                shardCount(shard_count_for(shardCount_, capacity_, byteLimit_)),
+                shardShift(64 - (size_type)std::countr_zero(shardCount)),
+                shards(new shard_type[shardCount])
+                {
+                    for(size_type idx = 0; idx < shardCount; ++idx)
+                    {
+                        shards[idx].capacityLimit = split_limit(capacityLimit, idx);
+                        shards[idx].byteLimit = byteLimit == std::numeric_limits<size_type>::max() ? byteLimit : split_limit(byteLimit, idx);
+                        shards[idx].buckets.reserve(std::min<size_type>(shards[idx].capacityLimit, BUCKET_POLICY::initial_capacity));
+                    }
+                }
+
+        ClockCache(const ClockCache&) = delete;
+        ClockCache& operator = (const ClockCache&) = delete;
+        ClockCache(ClockCache&&) = delete;
+        ClockCache& operator = (ClockCache&&) = delete;
+
+        virtual ~ClockCache()
+        {
+            for(size_type idx = 0; idx < shardCount; ++idx)
+            {
+                free_nodes(shards[idx]);
+            }
+        }
+
+        [[nodiscard]] inline size_type size() const noexcept
+        {
+            return cacheSize.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] inline size_type bytes() const noexcept
+        {
+            return cacheBytes.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] inline size_type capacity() const noexcept
+        {
+            return capacityLimit;
+        }
+
+        [[nodiscard]] inline size_type byte_limit() const noexcept
+        {
+            return byteLimit;
+        }
+
+        [[nodiscard]] inline size_type shard_count() const noexcept
+        {
+            return shardCount;
+        }
+
+        [[nodiscard]] std::optional<mapped_type> get(const key_type& key) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const shard_type& shard = shard_of(keyHash);
+            shared_lock_type lock(shard.mutex);
+            node_pointer node = shard.buckets.find(keyHash, key, keyEqual);
+            if (node != nullptr)
+            {
+                touch(node);
+                return node->data.second;
+            }
+            return std::nullopt;
+        }
+
+        template<typename FUNCTION>
+        bool visit(const key_type& key, FUNCTION&& function) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const shard_type& shard = shard_of(keyHash);
+            shared_lock_type lock(shard.mutex);
+            node_pointer node = shard.buckets.find(keyHash, key, keyEqual);
+            if (node != nullptr)
+            {
+                touch(node);
+                function(static_cast<const mapped_type&>(node->data.second));
+                return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const shard_type& shard = shard_of(keyHash);
+            shared_lock_type lock(shard.mutex);
+            return shard.buckets.find(keyHash, key, keyEqual) != nullptr;
+        }
+
+        template<typename MAPPED>
+        bool put(const key_type& key, MAPPED&& value)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            const size_type weight = (size_type)weightFun(key, value);
+            shard_type& shard = shard_of(keyHash);
+            unique_lock_type lock(shard.mutex);
+            node_pointer node = shard.buckets.find(keyHash, key, keyEqual);
+            if (weight > shard.byteLimit || shard.capacityLimit == 0)
+            {
+                if (node != nullptr)
+                {
+                    remove_node(shard, node);
+                }
+                return false;
+            }
+
+            if (node != nullptr)
+            {
+                node->data.second = std::forward<MAPPED>(value);
+                shard.shardBytes = shard.shardBytes - node->weight + weight;
+                cacheBytes.fetch_add(weight - node->weight, std::memory_order_relaxed);
+                node->weight = weight;
+                touch(node);
+                evict(shard, 0, 0);
+                return true;
+            }
+
+            evict(shard, 1, weight);
+            if (shard.shardSize + 1 > shard.buckets.capacity())
+            {
+                shard.buckets.reserve(shard.buckets.capacity() * 2);
+            }
+
+            try
+            {
+                node = shard.listAllocator.allocate(1);
+                new(node) node_type{value_type(key, std::forward<MAPPED>(value)), nullptr, nullptr, nullptr, keyHash, weight, 0};
+            } catch (std::bad_alloc)
+            {
+                return false;
+            } catch (...)
+            {
+                shard.listAllocator.deallocate(node, 1);
+                throw;
+            }
+
+            shard.buckets.link(node);
+            link_behind_hand(shard, node);
+            ++shard.shardSize;
+            shard.shardBytes += weight;
+            cacheSize.fetch_add(1, std::memory_order_relaxed);
+            cacheBytes.fetch_add(weight, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool erase(const key_type& key)
+        {
+            const size_type keyHash = (size_type)hashFun(key);
+            shard_type& shard = shard_of(keyHash);
+            unique_lock_type lock(shard.mutex);
+            node_pointer node = shard.buckets.find(keyHash, key, keyEqual);
+            if (node == nullptr)
+            {
+                return false;
+            }
+
+            remove_node(shard, node);
+            return true;
+        }
+
+        void clear()
+        {
+            for(size_type idx = 0; idx < shardCount; ++idx)
+            {
+                unique_lock_type lock(shards[idx].mutex);
+                free_nodes(shards[idx]);
+                shards[idx].buckets.clear();
+                cacheSize.fetch_sub(shards[idx].shardSize, std::memory_order_relaxed);
+                cacheBytes.fetch_sub(shards[idx].shardBytes, std::memory_order_relaxed);
+                shards[idx].hand = nullptr;
+                shards[idx].shardSize = 0;
+                shards[idx].shardBytes = 0;
+            }
+        }
+
+        template<typename FUNCTION>
+        void for_each(FUNCTION&& function) const
+        {
+            for(size_type idx = 0; idx < shardCount; ++idx)
+            {
+                shared_lock_type lock(shards[idx].mutex);
+                node_pointer node = shards[idx].hand;
+                for(size_type count = 0; count < shards[idx].shardSize; ++count)
+                {
+                    function(static_cast<const value_type&>(node->data));
+                    node = node->next;
+                }
+            }
+        }
+
+    private:
+
+        struct alignas(64) shard_type
+        {
+            mutable shared_mutex_type mutex;
+            list_allocator_type listAllocator;
+            CacheBuckets<node_type, ARRAY_ALLOCATOR, BUCKET_POLICY> buckets;
+            node_pointer hand{nullptr};
+            size_type shardSize{0};
+            size_type shardBytes{0};
+            size_type capacityLimit{0};
+            size_type byteLimit{0};
+        };
+
+        hasher hashFun;
+        key_equal keyEqual;
+        weigher weightFun;
+        std::atomic<size_type> cacheSize;
+        std::atomic<size_type> cacheBytes;
+        size_type capacityLimit;
+        size_type byteLimit;
+        size_type shardCount;
+        size_type shardShift;
+        std::unique_ptr<shard_type[]> shards;
+
+        [[nodiscard]] static size_type shard_count_for(const size_type shardCount_, const size_type capacity_, const size_type byteLimit_) noexcept
+        {
+            size_type count = std::bit_ceil(shardCount_ > 0 ? shardCount_ : 1);
+            while (count > 1 && (capacity_ / count == 0 || byteLimit_ / count < sizeof(KEY) + sizeof(VALUE)))
+            {
+                count >>= 1;
+            }
+            return count;
+        }
+
+        [[nodiscard]] inline size_type split_limit(const size_type limit, const size_type index) const noexcept
+        {
+            return limit / shardCount + (index < limit % shardCount ? 1 : 0);
+        }
+
+        [[nodiscard]] inline shard_type& shard_of(const size_type keyHash) const noexcept
+        {
+            if (shardCount == 1)
+            {
+                return shards[0];
+            }
+            return shards[(keyHash * 0x9E3779B97F4A7C15ull) >> shardShift];
+        }
+
+        static inline void touch(node_pointer node) noexcept
+        {
+            if (node->referenced.load(std::memory_order_relaxed) == 0)
+            {
+                node->referenced.store(1, std::memory_order_relaxed);
+            }
+        }
+
+        static void link_behind_hand(shard_type& shard, node_pointer node) noexcept
+        {
+            if (shard.hand == nullptr)
+            {
+                node->previous = node;
+                node->next = node;
+                shard.hand = node;
+                return;
+            }
+
+            node->next = shard.hand;
+            node->previous = shard.hand->previous;
+            shard.hand->previous->next = node;
+            shard.hand->previous = node;
+        }
+
+        void remove_node(shard_type& shard, node_pointer node) noexcept
+        {
+            shard.buckets.unlink(node);
+            if (node->next == node)
+            {
+                shard.hand = nullptr;
+            } else
+            {
+                if (shard.hand == node)
+                {
+                    shard.hand = node->next;
+                }
+                node->previous->next = node->next;
+                node->next->previous = node->previous;
+            }
+
+            --shard.shardSize;
+            shard.shardBytes -= node->weight;
+            cacheSize.fetch_sub(1, std::memory_order_relaxed);
+            cacheBytes.fetch_sub(node->weight, std::memory_order_relaxed);
+            (*node).~node_type();
+            shard.listAllocator.deallocate(node, 1);
+        }
+
+        void evict(shard_type& shard, const size_type extraCount, const size_type extraBytes) noexcept
+        {
+            while (shard.hand != nullptr && (shard.shardSize + extraCount > shard.capacityLimit || shard.shardBytes + extraBytes > shard.byteLimit))
+            {
+                node_pointer node = shard.hand;
+                if (node->referenced.load(std::memory_order_relaxed) != 0)
+                {
+                    node->referenced.store(0, std::memory_order_relaxed);
+                    shard.hand = node->next;
+                } else
+                {
+                    remove_node(shard, node);
+                }
+            }
+        }
+
+        static void free_nodes(shard_type& shard) noexcept
+        {
+            node_pointer node = shard.hand;
+            node_pointer deleteNode{nullptr};
+            for(size_type count = 0; count < shard.shardSize; ++count)
+            {
+                deleteNode = node;
+                node = node->next;
+                (*deleteNode).~node_type();
+                shard.listAllocator.deallocate(deleteNode, 1);
+            }
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_LRU_CACHE_H
@@ -0,0 +1,226 @@
+#ifndef INC_3DGAME_NODE_POOL_ALLOCATOR_H
+#define INC_3DGAME_NODE_POOL_ALLOCATOR_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace bice
+{
+
+    template<typename TYPE, std::uint64_t SLAB_SIZE = 256>
+    class NodePoolAllocator
+    {
+    public:
+
+        using value_type                               = TYPE;
+        using size_type                                = std::uint64_t;
+        using difference_type                          = std::int64_t;
+        using reference                                = TYPE&;
+        using const_reference                          = const TYPE&;
+        using pointer                                  = TYPE*;
+        using const_pointer                            = const TYPE*;
+        using propagate_on_container_copy_assignment   = std::false_type;
+        using propagate_on_container_move_assignment   = std::true_type;
+        using propagate_on_container_swap              = std::true_type;
+        using is_always_equal                          = std::false_type;
+
+        template<typename OTHER>
+        struct rebind
+        {
+            using other = NodePoolAllocator<OTHER, SLAB_SIZE>;
+        };
+
+        static_assert(SLAB_SIZE > 0, "Slab size must be greater than 0");
+
+        NodePoolAllocator() noexcept :
+        slabList{}, freeList{},
+        bumpBegin{}, bumpEnd{},
+        slabCount{}, liveCount{}
+        {}
+
+        NodePoolAllocator(const NodePoolAllocator&) noexcept :
+        slabList{}, freeList{},
+        bumpBegin{}, bumpEnd{},
+        slabCount{}, liveCount{}
+        {}
+
+        template<typename OTHER>
+        NodePoolAllocator(const NodePoolAllocator<OTHER, SLAB_SIZE>&) noexcept :
+        slabList{}, freeList{},
+        bumpBegin{}, bumpEnd{},
+        slabCount{}, liveCount{}
+        {}
+
+        NodePoolAllocator& operator = (const NodePoolAllocator&) noexcept
+        {
+            return *this;
+        }
+
+        NodePoolAllocator(NodePoolAllocator&& other) noexcept :
+        slabList(other.slabList), freeList(other.freeList),
+        bumpBegin(other.bumpBegin), bumpEnd(other.bumpEnd),
+        slabCount(other.slabCount), liveCount(other.liveCount)
+        {
+            other.slabList = nullptr;
+            other.freeList = nullptr;
+            other.bumpBegin = nullptr;
+            other.bumpEnd = nullptr;
+            other.slabCount = 0;
+            other.liveCount = 0;
+        }
+
+        NodePoolAllocator& operator = (NodePoolAllocator&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                slabList = other.slabList;
+                freeList = other.freeList;
+                bumpBegin = other.bumpBegin;
+                bumpEnd = other.bumpEnd;
+                slabCount = other.slabCount;
+                liveCount = other.liveCount;
+
+                other.slabList = nullptr;
+                other.freeList = nullptr;
+                other.bumpBegin = nullptr;
+                other.bumpEnd = nullptr;
+                other.slabCount = 0;
+                other.liveCount = 0;
+            }
+            return *this;
+        }
+
+        ~NodePoolAllocator()
+        {
+            release();
+        }
+
+        [[nodiscard]] pointer allocate(const size_type count)
+        {
+            if (count != 1)
+            {
+                return static_cast<pointer>(::operator new(count * sizeof(value_type), std::align_val_t(alignof(value_type))));
+            }
+
+            slot_pointer slot{nullptr};
+            if (freeList != nullptr)
+            {
+                slot = freeList;
+                freeList = freeList->next;
+            } else
+            {
+                if (bumpBegin == bumpEnd)
+                {
+                    add_slab(SLAB_SIZE);
+                }
+                slot = bumpBegin;
+                ++bumpBegin;
+            }
+
+            ++liveCount;
+            return reinterpret_cast<pointer>(slot->storage);
+        }
+
+        void deallocate(pointer node, const size_type count) noexcept
+        {
+            if (node == nullptr)
+            {
+                return;
+            }
+
+            if (count != 1)
+            {
+                ::operator delete(node, std::align_val_t(alignof(value_type)));
+                return;
+            }
+
+            auto slot = reinterpret_cast<slot_pointer>(node);
+            slot->next = freeList;
+            freeList = slot;
+            --liveCount;
+        }
+
+        void reserve(const size_type count)
+        {
+            if (count > (size_type)(bumpEnd - bumpBegin))
+            {
+                add_slab(count > SLAB_SIZE ? count : SLAB_SIZE);
+            }
+        }
+
+        [[nodiscard]] inline size_type available() const noexcept
+        {
+            return (size_type)(bumpEnd - bumpBegin);
+        }
+
+        void release() noexcept
+        {
+            while (slabList != nullptr)
+            {
+                slot_pointer nextSlab = slabList->next;
+                ::operator delete(slabList, std::align_val_t(alignof(slot_type)));
+                slabList = nextSlab;
+            }
+
+            freeList = nullptr;
+            bumpBegin = nullptr;
+            bumpEnd = nullptr;
+            slabCount = 0;
+            liveCount = 0;
+        }
+
+        [[nodiscard]] inline size_type slab_count() const noexcept
+        {
+            return slabCount;
+        }
+
+        [[nodiscard]] inline size_type allocated() const noexcept
+        {
+            return liveCount;
+        }
+
+        [[nodiscard]] inline bool operator == (const NodePoolAllocator& other) const noexcept
+        {
+            return this == &other;
+        }
+
+        [[nodiscard]] inline bool operator != (const NodePoolAllocator& other) const noexcept
+        {
+            return this != &other;
+        }
+
+    private:
+
+        union slot_type
+        {
+            slot_type* next;
+            alignas(value_type) unsigned char storage[sizeof(value_type)];
+        };
+
+        using slot_pointer                             = slot_type*;
+
+        slot_pointer slabList;
+        slot_pointer freeList;
+        slot_pointer bumpBegin;
+        slot_pointer bumpEnd;
+        size_type slabCount;
+        size_type liveCount;
+
+        void add_slab(const size_type count)
+        {
+            auto slab = static_cast<slot_pointer>(::operator new((count + 1) * sizeof(slot_type), std::align_val_t(alignof(slot_type))));
+            slab->next = slabList;
+            slabList = slab;
+            bumpBegin = slab + 1;
+            bumpEnd = bumpBegin + count;
+            ++slabCount;
+        }
+    };
+
+}
+
+#endif //INC_3DGAME_NODE_POOL_ALLOCATOR_H
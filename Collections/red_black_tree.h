@@ -7,8 +7,13 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
+#include <new>
 #include <utility>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
 
 namespace bice
 {
@@ -18,7 +23,7 @@ namespace bice
         BLACK
     };
 
-    template<typename TYPE>
+    template<typename TYPE, bool ORDER_STATISTICS = false>
     struct RedBlackTreeNode
     {
         using value_type                               = TYPE;
@@ -27,16 +32,16 @@ namespace bice
         using const_reference                          = const TYPE&;
         using pointer                                  = TYPE*;
         using const_pointer                            = const TYPE*;
-        using node_pointer                             = RedBlackTreeNode<TYPE>*;
-        using const_node_pointer                       = const RedBlackTreeNode<TYPE>*;
+        using node_pointer                             = RedBlackTreeNode<TYPE, ORDER_STATISTICS>*;
+        using const_node_pointer                       = const RedBlackTreeNode<TYPE, ORDER_STATISTICS>*;
 
-        [[nodiscard]] inline bool operator == (const RedBlackTreeNode<TYPE>& other) const noexcept
+        [[nodiscard]] inline bool operator == (const RedBlackTreeNode<TYPE, ORDER_STATISTICS>& other) const noexcept
         {
             return data == other.data && color == other.color && parent == other.parent &&
             left == other.left && right == other.right;
         }
 
-        [[nodiscard]] inline bool operator != (const RedBlackTreeNode<TYPE>& other) const noexcept
+        [[nodiscard]] inline bool operator != (const RedBlackTreeNode<TYPE, ORDER_STATISTICS>& other) const noexcept
         {
             return data != other.data || color != other.color || parent != other.parent ||
             left != other.left || right != other.right;
@@ -50,6 +55,39 @@ namespace bice
     };
 
     template<typename TYPE>
+    struct RedBlackTreeNode<TYPE, true>
+    {
+        using value_type                               = TYPE;
+        using size_type                                = std::uint64_t;
+        using color_type                               = RBTColor;
+        using reference                                = TYPE&;
+        using const_reference                          = const TYPE&;
+        using pointer                                  = TYPE*;
+        using const_pointer                            = const TYPE*;
+        using node_pointer                             = RedBlackTreeNode<TYPE, true>*;
+        using const_node_pointer                       = const RedBlackTreeNode<TYPE, true>*;
+
+        [[nodiscard]] inline bool operator == (const RedBlackTreeNode<TYPE, true>& other) const noexcept
+        {
+            return data == other.data && color == other.color && parent == other.parent &&
+            left == other.left && right == other.right;
+        }
+
+        [[nodiscard]] inline bool operator != (const RedBlackTreeNode<TYPE, true>& other) const noexcept
+        {
+            return data != other.data || color != other.color || parent != other.parent ||
+            left != other.left || right != other.right;
+        }
+
+        value_type data;
+        color_type color;
+        node_pointer parent;
+        node_pointer left;
+        node_pointer right;
+        size_type size{0};
+    };
+
+    template<typename TYPE, bool ORDER_STATISTICS = false>
     class RedBlackTreeIterator
     {
     public:
@@ -59,9 +97,9 @@ namespace bice
         using difference_type                          = std::int64_t;
         using reference                                = TYPE&;
         using pointer                                  = TYPE*;
-        using iterator                                 = RedBlackTreeIterator<value_type>;
-        using node_type                                = RedBlackTreeNode<value_type>;
-        using node_pointer                             = RedBlackTreeNode<value_type>*;
+        using iterator                                 = RedBlackTreeIterator<value_type, ORDER_STATISTICS>;
+        using node_type                                = RedBlackTreeNode<value_type, ORDER_STATISTICS>;
+        using node_pointer                             = RedBlackTreeNode<value_type, ORDER_STATISTICS>*;
 
         node_pointer node;
 
@@ -83,7 +121,7 @@ namespace bice
             return static_cast<pointer>(&node->data);
         }
 
-        [[nodiscard]] iterator& operator ++ () noexcept
+        iterator& operator ++ () noexcept
         {
             node = get_next(node);
             return *this;
@@ -96,7 +134,7 @@ namespace bice
             return temp;
         }
 
-        [[nodiscard]] iterator& operator -- () noexcept
+        iterator& operator -- () noexcept
         {
             node = get_previous(node);
             return *this;
@@ -111,14 +149,12 @@ namespace bice
 
         [[nodiscard]] bool operator == (const iterator& other) const noexcept
         {
-            return node->data == other.node->data && node->color == other.node->color && node->parent == other.node->parent &&
-            node->left == other.node->left && node->right == other.node->right;
+            return node == other.node;
         }
 
         [[nodiscard]] bool operator != (const iterator& other) const noexcept
         {
-            return node->data != other.node->data || node->color != other.node->color || node->parent != other.node->parent ||
-            node->left != other.node->left || node->right != other.node->right;
+            return node != other.node;
         }
 
     private:
@@ -246,7 +282,7 @@ namespace bice
         }
     };
 
-    template<typename TYPE>
+    template<typename TYPE, bool ORDER_STATISTICS = false>
     class ConstRedBlackTreeIterator
     {
     public:
@@ -256,9 +292,9 @@ namespace bice
         using difference_type                          = std::int64_t;
         using reference                                = const TYPE&;
         using pointer                                  = const TYPE*;
-        using iterator                                 = ConstRedBlackTreeIterator<value_type>;
-        using node_type                                = RedBlackTreeNode<value_type>;
-        using node_pointer                             = RedBlackTreeNode<value_type>*;
+        using iterator                                 = ConstRedBlackTreeIterator<value_type, ORDER_STATISTICS>;
+        using node_type                                = RedBlackTreeNode<value_type, ORDER_STATISTICS>;
+        using node_pointer                             = RedBlackTreeNode<value_type, ORDER_STATISTICS>*;
 
         node_pointer node;
 
@@ -280,7 +316,7 @@ namespace bice
             return static_cast<pointer>(&node->data);
         }
 
-        [[nodiscard]] iterator& operator ++ () noexcept
+        iterator& operator ++ () noexcept
         {
             node = get_next(node);
             return *this;
@@ -293,7 +329,7 @@ namespace bice
             return temp;
         }
 
-        [[nodiscard]] iterator& operator -- () noexcept
+        iterator& operator -- () noexcept
         {
             node = get_previous(node);
             return *this;
@@ -308,14 +344,12 @@ namespace bice
 
         [[nodiscard]] bool operator == (const iterator& other) const noexcept
         {
-            return node->data == other.node->data && node->color == other.node->color && node->parent == other.node->parent &&
-                   node->left == other.node->left && node->right == other.node->right;
+            return node == other.node;
         }
 
         [[nodiscard]] bool operator != (const iterator& other) const noexcept
         {
-            return node->data != other.node->data || node->color != other.node->color || node->parent != other.node->parent ||
-                   node->left != other.node->left || node->right != other.node->right;
+            return node != other.node;
         }
 
     private:
@@ -443,7 +477,34 @@ namespace bice
         }
     };
 
-    template<typename TYPE, typename ALLOCATOR = std::allocator<TYPE>>
+    template<typename ITERATOR>
+    class RedBlackTreeRange
+    {
+    public:
+
+        using iterator                                 = ITERATOR;
+
+        RedBlackTreeRange(const iterator first_, const iterator last_) noexcept :
+        first(first_), last(last_)
+        {}
+
+        [[nodiscard]] inline iterator begin() const noexcept
+        {
+            return first;
+        }
+
+        [[nodiscard]] inline iterator end() const noexcept
+        {
+            return last;
+        }
+
+    private:
+
+        iterator first;
+        iterator last;
+    };
+
+    template<typename TYPE, typename COMPARE = std::less<TYPE>, typename ALLOCATOR = std::allocator<TYPE>, bool ORDER_STATISTICS = false>
     class RedBlackTree
     {
     public:
@@ -451,24 +512,47 @@ namespace bice
         using value_type                               = TYPE;
         using size_type                                = std::uint64_t;
         using difference_type                          = std::int64_t;
+        using key_compare                              = COMPARE;
+        using value_compare                            = COMPARE;
         using allocator_type                           = ALLOCATOR;
-        using real_allocator_type                      = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<RedBlackTreeNode<TYPE>>;
+        using real_allocator_type                      = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<RedBlackTreeNode<TYPE, ORDER_STATISTICS>>;
         using reference                                = TYPE&;
         using const_reference                          = const TYPE&;
         using pointer                                  = TYPE*;
         using const_pointer                            = const TYPE*;
-        using node_type                                = RedBlackTreeNode<value_type>;
-        using node_pointer                             = RedBlackTreeNode<TYPE>*;
-        using const_node_pointer                       = const RedBlackTreeNode<TYPE>*;
-        using iterator                                 = RedBlackTreeIterator<value_type>;
-        using const_iterator                           = ConstRedBlackTreeIterator<value_type>;
+        using node_type                                = RedBlackTreeNode<value_type, ORDER_STATISTICS>;
+        using node_pointer                             = RedBlackTreeNode<TYPE, ORDER_STATISTICS>*;
+        using const_node_pointer                       = const RedBlackTreeNode<TYPE, ORDER_STATISTICS>*;
+        using iterator                                 = RedBlackTreeIterator<value_type, ORDER_STATISTICS>;
+        using const_iterator                           = ConstRedBlackTreeIterator<value_type, ORDER_STATISTICS>;
         using reverse_iterator	                       = std::reverse_iterator<iterator>;
         using const_reverse_iterator	               = std::reverse_iterator<const_iterator>;
+        using range_type                               = RedBlackTreeRange<iterator>;
+        using const_range_type                         = RedBlackTreeRange<const_iterator>;
+
+        template<typename K>
+        static constexpr bool is_transparent_key       = requires { typename COMPARE::is_transparent; }
+                                                         && std::is_invocable_r_v<bool, const COMPARE&, const TYPE&, const K&>
+                                                         && std::is_invocable_r_v<bool, const COMPARE&, const K&, const TYPE&>;
 
         RedBlackTree(allocator_type allocator_ = ALLOCATOR()) :
         allocator(allocator_),
+        compareFun(),
+        treeSize{},
+        rootNode{}, beginNode{}, endNode{},
+        slabList{}, freeNodes{}
+        {
+            initEndNode();
+            rootNode = endNode;
+            beginNode = endNode;
+        }
+
+        explicit RedBlackTree(key_compare compare_, allocator_type allocator_ = ALLOCATOR()) :
+        allocator(allocator_),
+        compareFun(compare_),
         treeSize{},
-        rootNode{}, beginNode{}, endNode{}
+        rootNode{}, beginNode{}, endNode{},
+        slabList{}, freeNodes{}
         {
             initEndNode();
             rootNode = endNode;
@@ -477,8 +561,10 @@ namespace bice
 
         explicit RedBlackTree(const_reference value, allocator_type allocator_ = ALLOCATOR()) :
         allocator(allocator_),
+        compareFun(),
         treeSize{},
-        rootNode{}, beginNode{}, endNode{}
+        rootNode{}, beginNode{}, endNode{},
+        slabList{}, freeNodes{}
         {
             initEndNode();
             node_pointer workNode{nullptr};
@@ -501,12 +587,15 @@ namespace bice
             endNode->parent = workNode;
             rootNode = workNode;
             beginNode = workNode;
+            update_size(workNode);
         }
 
         RedBlackTree(std::initializer_list<value_type> list, allocator_type allocator_ = ALLOCATOR()) :
         allocator(allocator_),
+        compareFun(),
         treeSize{},
-        rootNode{}, beginNode{}, endNode{}
+        rootNode{}, beginNode{}, endNode{},
+        slabList{}, freeNodes{}
         {
             initEndNode();
             if (endNode == nullptr)
@@ -515,20 +604,21 @@ namespace bice
             }
             for(auto iter = list.begin(); iter != list.end(); ++iter)
             {
-                push(std::forward<const_reference>(*iter));
-            }
-
-            if (treeSize < list.size())
-            {
-                clear();
+                if (!insert_or_fail(*iter))
+                {
+                    clear();
+                    break;
+                }
             }
         }
 
         template<typename ITERATOR>
         RedBlackTree(const ITERATOR begin, const ITERATOR end, allocator_type allocator_ = ALLOCATOR()) :
         allocator(allocator_),
+        compareFun(),
         treeSize{},
-        rootNode{}, beginNode{}, endNode{}
+        rootNode{}, beginNode{}, endNode{},
+        slabList{}, freeNodes{}
         {
             initEndNode();
             if (endNode == nullptr)
@@ -536,26 +626,30 @@ namespace bice
                 throw std::out_of_range("Tree is not initialized");
             }
 
-            difference_type distance{0};
             for(auto iter = begin; iter != end; ++iter)
             {
-                ++distance;
-            }
-            if (distance > 0)
-            {
-                for(auto iter = begin; iter != end; ++iter)
-                {
-                    push(std::forward<const_reference>(*iter));
-                }
-
-                if (treeSize < distance)
+                if (!insert_or_fail(*iter))
                 {
                     clear();
+                    break;
                 }
             }
         }
 
-        RedBlackTree(const RedBlackTree<TYPE, ALLOCATOR>& other)
+        template<typename ITERATOR> requires std::forward_iterator<ITERATOR>
+        [[nodiscard]] static RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS> from_sorted(const ITERATOR begin, const ITERATOR end,
+                                                                                   key_compare compare_ = COMPARE(),
+                                                                                   allocator_type allocator_ = ALLOCATOR())
+        {
+            RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS> tree(compare_, allocator_);
+            tree.build_sorted(begin, end);
+            return tree;
+        }
+
+        RedBlackTree(const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) :
+        allocator(std::allocator_traits<real_allocator_type>::select_on_container_copy_construction(other.allocator)),
+        compareFun(other.compareFun),
+        slabList{}, freeNodes{}
         {
             initEndNode();
             rootNode = endNode;
@@ -563,61 +657,80 @@ namespace bice
             treeSize = 0;
             if (other.treeSize > 0)
             {
-                copy_fun(other.rootNode, other.endNode);
-
-                if (treeSize < other.treeSize)
-                {
-                    clear();
-                }
+                copy_tree(other);
             }
         }
 
-        RedBlackTree<TYPE, ALLOCATOR>& operator = (const RedBlackTree<TYPE, ALLOCATOR>& other)
+        RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& operator = (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other)
         {
+            if (this == &other)
+            {
+                return *this;
+            }
+
             clear_fun(rootNode);
+            release_slabs();
 
+            compareFun = other.compareFun;
             treeSize = 0;
             rootNode = endNode;
             beginNode = endNode;
+            if (endNode != nullptr)
+            {
+                endNode->parent = nullptr;
+            }
 
             if (other.treeSize > 0)
             {
-                copy_fun(other.rootNode, other.endNode);
-
-                if (treeSize < other.treeSize)
-                {
-                    clear();
-                }
+                copy_tree(other);
             }
 
             return *this;
         }
 
-        RedBlackTree(RedBlackTree<TYPE, ALLOCATOR>&& other) noexcept :
+        RedBlackTree(RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>&& other) noexcept :
+        allocator(std::move(other.allocator)),
+        compareFun(std::move(other.compareFun)),
         treeSize(std::move(other.treeSize)),
         rootNode(std::move(other.rootNode)),
         beginNode(std::move(other.beginNode)),
-        endNode(std::move(other.endNode))
+        endNode(std::move(other.endNode)),
+        slabList(other.slabList),
+        freeNodes(other.freeNodes)
         {
             other.treeSize = 0;
             other.rootNode = nullptr;
             other.beginNode = nullptr;
             other.endNode = nullptr;
+            other.slabList = nullptr;
+            other.freeNodes = nullptr;
         }
 
-        RedBlackTree<TYPE, ALLOCATOR>& operator = (RedBlackTree<TYPE, ALLOCATOR>&& other) noexcept
+        RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& operator = (RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>&& other) noexcept
         {
+            if (this == &other)
+            {
+                return *this;
+            }
+
             clear_destructor(rootNode);
+            release_slabs();
 
+            allocator = std::move(other.allocator);
+            compareFun = std::move(other.compareFun);
             treeSize = std::move(other.treeSize);
             rootNode = std::move(other.rootNode);
             beginNode = std::move(other.beginNode);
             endNode = std::move(other.endNode);
+            slabList = other.slabList;
+            freeNodes = other.freeNodes;
 
             other.treeSize = 0;
             other.rootNode = nullptr;
             other.beginNode = nullptr;
             other.endNode = nullptr;
+            other.slabList = nullptr;
+            other.freeNodes = nullptr;
 
             return *this;
         }
@@ -625,6 +738,7 @@ namespace bice
         virtual ~RedBlackTree()
         {
             clear_destructor(rootNode);
+            release_slabs();
         }
 
         [[nodiscard]] inline iterator begin() noexcept
@@ -773,1137 +887,238 @@ namespace bice
 
         iterator find(const_reference value)
         {
-            if (endNode == nullptr && treeSize == 0)
-            {
-                throw std::out_of_range("Tree is not initialized");
-            } else if (treeSize == 0 && endNode != nullptr)
-            {
-                return iterator(endNode);
-            } else
-            {
-                node_pointer currentNode = rootNode;
-                node_pointer findNode{};
+            return iterator(find_node(value));
+        }
 
-                while (true)
-                {
-                    if (value == currentNode->data)
-                    {
-                        findNode = currentNode;
-                        break;
-                    } else if (value > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            findNode = endNode;
-                            break;
-                        }
-                    } else if (value < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            findNode = endNode;
-                            break;
-                        }
-                    }
-                }
+        const_iterator find(const_reference value) const
+        {
+            return const_iterator(find_node(value));
+        }
 
-                return iterator(findNode);
-            }
+        template<typename K> requires is_transparent_key<K>
+        iterator find(const K& value)
+        {
+            return iterator(find_node(value));
         }
 
-        void push(const_reference value)
+        template<typename K> requires is_transparent_key<K>
+        const_iterator find(const K& value) const
         {
-            if (treeSize == 0)
-            {
-                if (endNode == nullptr)
-                {
-                    initEndNode();
-                    beginNode = endNode;
-                    rootNode = endNode;
-                }
-                if (endNode == nullptr)
-                {
-                    throw std::out_of_range("Tree is not initialized");
-                }
+            return const_iterator(find_node(value));
+        }
 
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(value), RBTColor::BLACK, nullptr, nullptr, endNode};
-                } catch (std::bad_alloc)
-                {
-                    return;
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return;
-                }
+        [[nodiscard]] bool contains(const_reference value) const
+        {
+            return find_node(value) != endNode;
+        }
 
-                treeSize = 1;
-                rootNode = workNode;
-                endNode->parent = workNode;
-                beginNode = workNode;
-            } else if (treeSize > 0)
-            {
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(value), RBTColor::RED, nullptr, nullptr, nullptr};
-                } catch (std::bad_alloc)
-                {
-                    return;
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return;
-                }
-                node_pointer currentNode = rootNode;
+        template<typename K> requires is_transparent_key<K>
+        [[nodiscard]] bool contains(const K& value) const
+        {
+            return find_node(value) != endNode;
+        }
 
-                while (true)
-                {
-                    if (value < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            currentNode->left = workNode;
-                            if (currentNode == beginNode)
-                            {
-                                beginNode = workNode;
-                            }
-                            ++treeSize;
-                            break;
-                        }
-                    } else if (value > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode->right != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            if (currentNode->right == endNode)
-                            {
-                                workNode->right = endNode;
-                                endNode->parent = workNode;
-                            }
-                            currentNode->right = workNode;
-                            ++treeSize;
-                            break;
-                        }
-                    }
-                }
+        iterator lower_bound(const_reference value)
+        {
+            return iterator(lower_bound_node(value));
+        }
 
-                fix_insert(workNode);
-            }
+        const_iterator lower_bound(const_reference value) const
+        {
+            return const_iterator(lower_bound_node(value));
         }
 
-        void push(value_type&& value)
+        template<typename K> requires is_transparent_key<K>
+        iterator lower_bound(const K& value)
         {
-            if (treeSize == 0)
-            {
-                if (endNode == nullptr)
-                {
-                    initEndNode();
-                    beginNode = endNode;
-                    rootNode = endNode;
-                }
-                if (endNode == nullptr)
-                {
-                    throw std::out_of_range("Tree is not initialized");
-                }
+            return iterator(lower_bound_node(value));
+        }
 
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                } catch (std::bad_alloc)
-                {
-                    return;
-                }
+        template<typename K> requires is_transparent_key<K>
+        const_iterator lower_bound(const K& value) const
+        {
+            return const_iterator(lower_bound_node(value));
+        }
 
-                new(workNode) node_type{value_type(std::move(value)), RBTColor::BLACK, nullptr, nullptr, endNode};
+        iterator upper_bound(const_reference value)
+        {
+            return iterator(upper_bound_node(value));
+        }
 
-                treeSize = 1;
-                rootNode = workNode;
-                endNode->parent = workNode;
-                beginNode = workNode;
-            } else if (treeSize > 0)
-            {
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                } catch (std::bad_alloc)
-                {
-                    return;
-                }
+        const_iterator upper_bound(const_reference value) const
+        {
+            return const_iterator(upper_bound_node(value));
+        }
 
-                new(workNode) node_type{value_type(std::move(value)), RBTColor::RED, nullptr, nullptr, nullptr};
+        template<typename K> requires is_transparent_key<K>
+        iterator upper_bound(const K& value)
+        {
+            return iterator(upper_bound_node(value));
+        }
 
-                node_pointer currentNode = rootNode;
+        template<typename K> requires is_transparent_key<K>
+        const_iterator upper_bound(const K& value) const
+        {
+            return const_iterator(upper_bound_node(value));
+        }
 
-                while (true)
-                {
-                    if (value < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            currentNode->left = workNode;
-                            if (currentNode == beginNode)
-                            {
-                                beginNode = workNode;
-                            }
-                            ++treeSize;
-                            break;
-                        }
-                    } else if (value > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode->right != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            if (currentNode->right == endNode)
-                            {
-                                workNode->right = endNode;
-                                endNode->parent = workNode;
-                            }
-                            currentNode->right = workNode;
-                            ++treeSize;
-                            break;
-                        }
-                    }
-                }
+        std::pair<iterator, iterator> equal_range(const_reference value)
+        {
+            const auto [lowerNode, upperNode] = equal_range_nodes(value);
+            return std::pair<iterator, iterator>(iterator(lowerNode), iterator(upperNode));
+        }
 
-                fix_insert(workNode);
-            }
+        std::pair<const_iterator, const_iterator> equal_range(const_reference value) const
+        {
+            const auto [lowerNode, upperNode] = equal_range_nodes(value);
+            return std::pair<const_iterator, const_iterator>(const_iterator(lowerNode), const_iterator(upperNode));
         }
 
-        std::pair<iterator, bool> insert(const_reference value)
+        template<typename K> requires is_transparent_key<K>
+        std::pair<iterator, iterator> equal_range(const K& value)
         {
-            if (treeSize == 0)
-            {
-                if (endNode == nullptr)
-                {
-                    beginNode = nullptr;
-                    rootNode = nullptr;
-                    initEndNode();
-                }
-                if (endNode == nullptr)
-                {
-                    throw std::out_of_range("Tree is not initialized");
-                }
+            const auto [lowerNode, upperNode] = equal_range_nodes(value);
+            return std::pair<iterator, iterator>(iterator(lowerNode), iterator(upperNode));
+        }
 
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(value), RBTColor::BLACK, nullptr, nullptr, endNode};
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
+        template<typename K> requires is_transparent_key<K>
+        std::pair<const_iterator, const_iterator> equal_range(const K& value) const
+        {
+            const auto [lowerNode, upperNode] = equal_range_nodes(value);
+            return std::pair<const_iterator, const_iterator>(const_iterator(lowerNode), const_iterator(upperNode));
+        }
 
-                treeSize = 1;
-                rootNode = workNode;
-                endNode->parent = workNode;
-                beginNode = workNode;
-                return std::pair<iterator, bool>(iterator(workNode), true);
-            } else if (treeSize > 0)
-            {
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(value), RBTColor::RED, nullptr, nullptr, nullptr};
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
-                node_pointer currentNode = rootNode;
+        range_type range(const_reference low, const_reference high)
+        {
+            const auto [firstNode, lastNode] = range_nodes(low, high);
+            return range_type(iterator(firstNode), iterator(lastNode));
+        }
 
-                while (true)
-                {
-                    if (value < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            currentNode->left = workNode;
-                            if (currentNode == beginNode)
-                            {
-                                beginNode = workNode;
-                            }
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (value > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode->right != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            if (currentNode->right == endNode)
-                            {
-                                workNode->right = endNode;
-                                endNode->parent = workNode;
-                            }
-                            currentNode->right = workNode;
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (value == currentNode->data)
-                    {
-                        return std::pair<iterator, bool>(iterator(currentNode), true);
-                    }
-                }
-            }
+        const_range_type range(const_reference low, const_reference high) const
+        {
+            const auto [firstNode, lastNode] = range_nodes(low, high);
+            return const_range_type(const_iterator(firstNode), const_iterator(lastNode));
+        }
 
-            return std::pair<iterator, bool>(iterator(endNode), false);
+        template<typename K> requires is_transparent_key<K>
+        range_type range(const K& low, const K& high)
+        {
+            const auto [firstNode, lastNode] = range_nodes(low, high);
+            return range_type(iterator(firstNode), iterator(lastNode));
         }
 
-        std::pair<iterator, bool> insert(value_type&& value)
+        template<typename K> requires is_transparent_key<K>
+        const_range_type range(const K& low, const K& high) const
         {
-            if (treeSize == 0)
-            {
-                if (endNode == nullptr)
-                {
-                    beginNode = nullptr;
-                    rootNode = nullptr;
-                    initEndNode();
-                }
-                if (endNode == nullptr)
-                {
-                    throw std::out_of_range("Tree is not initialized");
-                }
+            const auto [firstNode, lastNode] = range_nodes(low, high);
+            return const_range_type(const_iterator(firstNode), const_iterator(lastNode));
+        }
 
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
+        iterator nth_element(const size_type index) requires ORDER_STATISTICS
+        {
+            return iterator(nth_node(index));
+        }
 
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
+        const_iterator nth_element(const size_type index) const requires ORDER_STATISTICS
+        {
+            return const_iterator(nth_node(index));
+        }
 
-                new(workNode) node_type{value_type(std::move(value)), RBTColor::BLACK, nullptr, nullptr, endNode};
+        [[nodiscard]] size_type rank(const_reference value) const requires ORDER_STATISTICS
+        {
+            return rank_node(value);
+        }
 
-                treeSize = 1;
-                rootNode = workNode;
-                endNode->parent = workNode;
-                beginNode = workNode;
-                return std::pair<iterator, bool>(iterator(workNode), true);
-            } else if (treeSize > 0)
-            {
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
+        template<typename K> requires ORDER_STATISTICS && is_transparent_key<K>
+        [[nodiscard]] size_type rank(const K& value) const
+        {
+            return rank_node(value);
+        }
 
-                new(workNode) node_type{value_type(std::move(value)), RBTColor::RED, nullptr, nullptr, nullptr};
+        void push(const_reference value)
+        {
+            insert_value(value);
+        }
 
-                node_pointer currentNode = rootNode;
+        void push(value_type&& value)
+        {
+            insert_value(std::move(value));
+        }
 
-                while (true)
-                {
-                    if (value < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            currentNode->left = workNode;
-                            if (currentNode == beginNode)
-                            {
-                                beginNode = workNode;
-                            }
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (value > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode->right != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            if (currentNode->right == endNode)
-                            {
-                                workNode->right = endNode;
-                                endNode->parent = workNode;
-                            }
-                            currentNode->right = workNode;
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (value == currentNode->data)
-                    {
-                        return std::pair<iterator, bool>(iterator(currentNode), true);
-                    }
-                }
-            }
+        std::pair<iterator, bool> insert(const_reference value)
+        {
+            return insert_value(value);
+        }
 
-            return std::pair<iterator, bool>(iterator(endNode), false);
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return insert_value(std::move(value));
         }
 
         template<typename... Args >
         std::pair<iterator, bool> emplace(Args... args)
         {
-            if (treeSize == 0)
-            {
-                if (endNode == nullptr)
-                {
-                    beginNode = nullptr;
-                    rootNode = nullptr;
-                    initEndNode();
-                }
-                if (endNode == nullptr)
-                {
-                    throw std::out_of_range("Tree is not initialized");
-                }
-
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(std::forward<Args>(args)...), RBTColor::BLACK, nullptr, nullptr, endNode};
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
+            ensure_end_node();
 
-                treeSize = 1;
-                rootNode = workNode;
-                endNode->parent = workNode;
-                beginNode = workNode;
-                return std::pair<iterator, bool>(iterator(workNode), true);
-            } else if (treeSize > 0)
+            node_pointer workNode{nullptr};
+            try
             {
-                node_pointer workNode{nullptr};
-                try
-                {
-                    workNode = allocator.allocate(1);
-                    new(workNode) node_type{value_type(std::forward<Args>(args)...), RBTColor::RED, nullptr, nullptr, nullptr};
-                } catch (std::bad_alloc)
-                {
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                } catch (...)
-                {
-                    (*workNode).~node_type();
-                    allocator.deallocate(workNode, 1);
-                    return std::pair<iterator, bool>(iterator(endNode), false);
-                }
-                node_pointer currentNode = rootNode;
+                workNode = acquire_node();
+                new(workNode) node_type{value_type(std::forward<Args>(args)...), RBTColor::RED, nullptr, nullptr, nullptr};
+            } catch (std::bad_alloc)
+            {
+                return std::pair<iterator, bool>(iterator(endNode), false);
+            } catch (...)
+            {
+                release_node(workNode);
+                return std::pair<iterator, bool>(iterator(endNode), false);
+            }
 
-                while (true)
-                {
-                    if (workNode->data < currentNode->data)
-                    {
-                        if (currentNode->left != nullptr)
-                        {
-                            currentNode = currentNode->left;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            currentNode->left = workNode;
-                            if (currentNode == beginNode)
-                            {
-                                beginNode = workNode;
-                            }
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (workNode->data > currentNode->data)
-                    {
-                        if (currentNode->right != nullptr && currentNode->right != endNode)
-                        {
-                            currentNode = currentNode->right;
-                            continue;
-                        } else
-                        {
-                            workNode->parent = currentNode;
-                            if (currentNode->right == endNode)
-                            {
-                                workNode->right = endNode;
-                                endNode->parent = workNode;
-                            }
-                            currentNode->right = workNode;
-                            ++treeSize;
-                            fix_insert(workNode);
-                            return std::pair<iterator, bool>(iterator(workNode), true);
-                        }
-                    } else if (workNode->data == currentNode->data)
-                    {
-                        return std::pair<iterator, bool>(iterator(currentNode), true);
-                    }
-                }
+            bool insertLeft{true};
+            node_pointer equalNode{nullptr};
+            node_pointer parentNode = insert_position(workNode->data, insertLeft, equalNode);
+            if (equalNode != nullptr)
+            {
+                (*workNode).~node_type();
+                release_node(workNode);
+                return std::pair<iterator, bool>(iterator(equalNode), false);
             }
 
-            return std::pair<iterator, bool>(iterator(endNode), false);
+            attach_node(workNode, parentNode, insertLeft);
+            return std::pair<iterator, bool>(iterator(workNode), true);
         }
 
         void remove(const_reference value)
         {
             if (treeSize > 0)
             {
-                iterator findIter = find(value);
-                node_pointer removeNode = findIter.node;
+                node_pointer removeNode = find(value).node;
                 if (removeNode != endNode)
                 {
-                    node_pointer parentNode{nullptr};
-                    node_pointer childNode{nullptr};
-                    RBTColor removeColor;
-                    if ((removeNode->left == nullptr && removeNode->right == nullptr) ||
-                        (removeNode->left == nullptr && removeNode->right == endNode))
-                    {
-                        if (rootNode == removeNode)
-                        {
-                            if (removeNode->right == endNode)
-                            {
-                                endNode->parent = nullptr;
-                            }
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-                            rootNode = endNode;
-                            beginNode = endNode;
-                            endNode->parent = nullptr;
-                            treeSize = 0;
-                            return;
-                        } else
-                        {
-                            parentNode = removeNode->parent;
-                            removeColor = removeNode->color;
-                            childNode = removeNode->right;
-                            if (parentNode->left == removeNode)
-                            {
-                                parentNode->left = nullptr;
-                                if (removeNode == beginNode)
-                                {
-                                    beginNode = parentNode;
-                                }
-                                (*removeNode).~node_type();
-                                allocator.deallocate(removeNode, 1);
-                                --treeSize;
-
-                                if (removeColor == RBTColor::BLACK)
-                                {
-                                    fix_delete(childNode, parentNode, true);
-                                }
-                            } else
-                            {
-                                if (removeNode->right == endNode)
-                                {
-                                    endNode->parent = parentNode;
-                                    parentNode->right = endNode;
-                                } else
-                                {
-                                    parentNode->right = nullptr;
-                                }
-
-                                (*removeNode).~node_type();
-                                allocator.deallocate(removeNode, 1);
-                                --treeSize;
-                                if (removeColor == RBTColor::BLACK)
-                                {
-                                    fix_delete(childNode, parentNode, false);
-                                }
-                            }
-                        }
-                    } else if ((removeNode->left != nullptr && removeNode->right == nullptr) ||
-                               (removeNode->left != nullptr && removeNode->right == endNode))
-                    {
-                        parentNode = removeNode->parent;
-                        removeColor = removeNode->color;
-                        childNode = removeNode->left;
-                        if (rootNode == removeNode)
-                        {
-                            node_pointer leftChildNode = removeNode->left;
-                            leftChildNode->parent = nullptr;
-                            if (removeNode->right == endNode)
-                            {
-                                node_pointer leftRightNode = leftChildNode;
-                                while (leftRightNode->right != nullptr)
-                                {
-                                    leftRightNode = leftRightNode->right;
-                                }
-
-                                leftRightNode->right = endNode;
-                                endNode->parent = leftRightNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            rootNode = leftChildNode;
-                            --treeSize;
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, true);
-                            }
-
-                        } else
-                        {
-                            node_pointer leftChildNode = removeNode->left;
-                            parentNode = removeNode->parent;
-
-                            auto isNodeLeft = parentNode->left == removeNode;
-
-                            if (removeNode->right == endNode)
-                            {
-                                node_pointer leftRightNode = leftChildNode;
-                                while (leftRightNode->right != nullptr)
-                                {
-                                    leftRightNode = leftRightNode->right;
-                                }
-
-                                leftRightNode->right = endNode;
-                                endNode->parent = leftRightNode;
-                            }
-
-                            if (isNodeLeft)
-                            {
-                                parentNode->left = leftChildNode;
-                                leftChildNode->parent = parentNode;
-                            } else
-                            {
-                                parentNode->right = leftChildNode;
-                                leftChildNode->parent = parentNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            --treeSize;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, true);
-                            }
-                        }
-                    } else if ((removeNode->left == nullptr && removeNode->right != nullptr) ||
-                               (removeNode->left == nullptr && removeNode->right != endNode))
-                    {
-                        removeColor = removeNode->color;
-                        parentNode = removeNode->parent;
-                        childNode = removeNode->right;
-                        if (removeNode == rootNode)
-                        {
-                            node_pointer rightChildNode = removeNode->right;
-                            rightChildNode->parent = nullptr;
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            rootNode = rightChildNode;
-                            beginNode = rightChildNode;
-                            --treeSize;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, false);
-                            }
-
-                        } else
-                        {
-                            node_pointer rightChildNode = removeNode->right;
-                            parentNode = removeNode->parent;
-
-                            if (removeNode == beginNode)
-                            {
-                                beginNode = rightChildNode;
-                            }
-
-                            auto isNodeLeft = parentNode->left == removeNode;
-
-                            if (isNodeLeft)
-                            {
-                                parentNode->left = rightChildNode;
-                                rightChildNode->parent = parentNode;
-                            } else
-                            {
-                                parentNode->right = rightChildNode;
-                                rightChildNode->parent = parentNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            --treeSize;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, false);
-                            }
-                        }
-
-                    } else if ((removeNode->left != nullptr && removeNode->right != nullptr) ||
-                               (removeNode->left != nullptr && removeNode->right != endNode))
-                    {
-                        /*if (removeNode == rootNode)
-                        {
-                            node_pointer successorNode = removeNode->right;
-                            while (successorNode->left != nullptr)
-                            {
-                                successorNode = successorNode->left;
-                            }
-
-                            childNode = successorNode;
-
-                            removeNode->fileData = std::move(successorNode->fileData);
-
-                            node_pointer successorParent = successorNode->parent;
-                            node_pointer successorChild = successorNode->right;
-                            removeColor = successorNode->color;
-                            parentNode = successorParent;
-                            childNode = successorChild;
-
-                            bool isLeft;
-
-                            if (successorParent->right == successorNode)
-                            {
-                                successorParent->right = successorChild;
-                                isLeft = false;
-                            } else
-                            {
-                                successorParent->left = successorChild;
-                                isLeft = true;
-                            }
-                            successorChild->parent = successorParent;
-
-                            (*successorNode).~node_type();
-                            allocator.deallocate(successorNode, 1);
-
-                            --treeSize;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, isLeft);
-                            }
-
-                        } else
-                        {
-                            node_pointer successorNode = removeNode->right;
-                            while (successorNode->left != nullptr)
-                            {
-                                successorNode = successorNode->left;
-                            }
-
-                            node_pointer successorParent = successorNode->parent;
-                            node_pointer successorChild = successorNode->right;
-                            removeColor = successorNode->color;
-                            parentNode = successorParent;
-                            childNode = successorChild;
-
-                            removeNode->fileData = std::move(successorNode->fileData);
-
-                            bool isLeft;
-                            if (successorParent->right == successorNode)
-                            {
-                                successorParent->right = successorChild;
-                                isLeft = false;
-                            } else
-                            {
-                                successorParent->left = successorChild;
-                                isLeft = true;
-                            }
-                            successorChild->parent = successorParent;
-
-                            --treeSize;
-
-                            (*successorNode).~node_type();
-                            allocator.deallocate(successorNode, 1);
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, isLeft);
-                            }
-                        }*/
-
-                        node_pointer successorNode = removeNode->right;
-                        while (successorNode->left != nullptr)
-                        {
-                            successorNode = successorNode->left;
-                        }
-
-                        childNode = successorNode;
-
-                        removeNode->data = std::move(successorNode->data);
-
-                        node_pointer successorParent = successorNode->parent;
-                        node_pointer successorChild = successorNode->right;
-                        removeColor = successorNode->color;
-                        parentNode = successorParent;
-                        childNode = successorChild;
-
-                        bool isLeft;
-
-                        if (successorParent->right == successorNode)
-                        {
-                            successorParent->right = successorChild;
-                            isLeft = false;
-                        } else
-                        {
-                            successorParent->left = successorChild;
-                            isLeft = true;
-                        }
-                        if (successorChild != nullptr)
-                        {
-                            successorChild->parent = successorParent;
-                        }
-
-                        (*successorNode).~node_type();
-                        allocator.deallocate(successorNode, 1);
-
-                        --treeSize;
-
-                        if (removeColor == RBTColor::BLACK)
-                        {
-                            fix_delete(childNode, parentNode, isLeft);
-                        }
-                    }
+                    erase_node(removeNode);
                 }
             }
         }
 
         void remove(iterator element)
         {
-            if (treeSize > 0)
+            if (treeSize > 0 && element.node != nullptr && element.node != endNode)
             {
-                node_pointer removeNode = element.node;
-                if (removeNode != endNode)
-                {
-                    node_pointer parentNode{nullptr};
-                    node_pointer childNode{nullptr};
-                    RBTColor removeColor;
-                    if ((removeNode->left == nullptr && removeNode->right == nullptr) ||
-                        (removeNode->left == nullptr && removeNode->right == endNode))
-                    {
-                        if (rootNode == removeNode)
-                        {
-                            if (removeNode->right == endNode)
-                            {
-                                endNode->parent = nullptr;
-                            }
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-                            rootNode = endNode;
-                            beginNode = endNode;
-                            endNode->parent = nullptr;
-                            treeSize = 0;
-                            return;
-                        } else
-                        {
-                            parentNode = removeNode->parent;
-                            removeColor = removeNode->color;
-                            childNode = removeNode->right;
-                            if (parentNode->left == removeNode)
-                            {
-                                parentNode->left = nullptr;
-                                if (removeNode == beginNode)
-                                {
-                                    beginNode = parentNode;
-                                }
-                                (*removeNode).~node_type();
-                                allocator.deallocate(removeNode, 1);
-                                --treeSize;
-
-                                if (removeColor == RBTColor::BLACK)
-                                {
-                                    fix_delete(childNode, parentNode, true);
-                                }
-                            } else
-                            {
-                                if (removeNode->right == endNode)
-                                {
-                                    endNode->parent = parentNode;
-                                    parentNode->right = endNode;
-                                } else
-                                {
-                                    parentNode->right = nullptr;
-                                }
-
-                                (*removeNode).~node_type();
-                                allocator.deallocate(removeNode, 1);
-                                --treeSize;
-                                if (removeColor == RBTColor::BLACK)
-                                {
-                                    fix_delete(childNode, parentNode, false);
-                                }
-                            }
-                        }
-                    } else if ((removeNode->left != nullptr && removeNode->right == nullptr) ||
-                               (removeNode->left != nullptr && removeNode->right == endNode))
-                    {
-                        parentNode = removeNode->parent;
-                        removeColor = removeNode->color;
-                        childNode = removeNode->left;
-                        if (rootNode == removeNode)
-                        {
-                            node_pointer leftChildNode = removeNode->left;
-                            leftChildNode->parent = nullptr;
-                            if (removeNode->right == endNode)
-                            {
-                                node_pointer leftRightNode = leftChildNode;
-                                while (leftRightNode->right != nullptr)
-                                {
-                                    leftRightNode = leftRightNode->right;
-                                }
-
-                                leftRightNode->right = endNode;
-                                endNode->parent = leftRightNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            rootNode = leftChildNode;
-                            --treeSize;
-
-                            node_pointer minimumNode = rootNode;
-                            while (minimumNode->left != nullptr)
-                            {
-                                minimumNode = minimumNode->left;
-                            }
-                            beginNode = minimumNode;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, true);
-                            }
-
-                        } else
-                        {
-                            node_pointer leftChildNode = removeNode->left;
-                            parentNode = removeNode->parent;
-
-                            auto isNodeLeft = parentNode->left == removeNode;
-
-                            if (removeNode->right == endNode)
-                            {
-                                node_pointer leftRightNode = leftChildNode;
-                                while (leftRightNode->right != nullptr)
-                                {
-                                    leftRightNode = leftRightNode->right;
-                                }
-
-                                leftRightNode->right = endNode;
-                                endNode->parent = leftRightNode;
-                            }
-
-                            if (isNodeLeft)
-                            {
-                                parentNode->left = leftChildNode;
-                                leftChildNode->parent = parentNode;
-                            } else
-                            {
-                                parentNode->right = leftChildNode;
-                                leftChildNode->parent = parentNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            --treeSize;
-
-                            node_pointer minimumNode = rootNode;
-                            while (minimumNode->left != nullptr)
-                            {
-                                minimumNode = minimumNode->left;
-                            }
-                            beginNode = minimumNode;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, true);
-                            }
-                        }
-                    } else if ((removeNode->left == nullptr && removeNode->right != nullptr) ||
-                               (removeNode->left == nullptr && removeNode->right != endNode))
-                    {
-                        removeColor = removeNode->color;
-                        parentNode = removeNode->parent;
-                        childNode = removeNode->right;
-                        if (removeNode == rootNode)
-                        {
-                            node_pointer rightChildNode = removeNode->right;
-                            rightChildNode->parent = nullptr;
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            rootNode = rightChildNode;
-                            --treeSize;
-
-                            node_pointer minimumNode = rootNode;
-                            while (minimumNode->left != nullptr)
-                            {
-                                minimumNode = minimumNode->left;
-                            }
-                            beginNode = minimumNode;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, false);
-                            }
-
-                        } else
-                        {
-                            node_pointer rightChildNode = removeNode->right;
-                            parentNode = removeNode->parent;
-
-                            auto isNodeLeft = parentNode->left == removeNode;
-
-                            if (isNodeLeft)
-                            {
-                                parentNode->left = rightChildNode;
-                                rightChildNode->parent = parentNode;
-                            } else
-                            {
-                                parentNode->right = rightChildNode;
-                                rightChildNode->parent = parentNode;
-                            }
-
-                            (*removeNode).~node_type();
-                            allocator.deallocate(removeNode, 1);
-
-                            --treeSize;
-
-                            node_pointer minimumNode = rootNode;
-                            while (minimumNode->left != nullptr)
-                            {
-                                minimumNode = minimumNode->left;
-                            }
-                            beginNode = minimumNode;
-
-                            if (removeColor == RBTColor::BLACK)
-                            {
-                                fix_delete(childNode, parentNode, false);
-                            }
-                        }
-
-                    } else if ((removeNode->left != nullptr && removeNode->right != nullptr) ||
-                               (removeNode->left != nullptr && removeNode->right != endNode))
-                    {
-
-                        node_pointer successorNode = removeNode->right;
-                        while (successorNode->left != nullptr)
-                        {
-                            successorNode = successorNode->left;
-                        }
-
-                        childNode = successorNode;
-
-                        removeNode->data = std::move(successorNode->data);
-
-                        node_pointer successorParent = successorNode->parent;
-                        node_pointer successorChild = successorNode->right;
-                        removeColor = successorNode->color;
-                        parentNode = successorParent;
-                        childNode = successorChild;
-
-                        bool isLeft;
-
-                        if (successorParent->right == successorNode)
-                        {
-                            successorParent->right = successorChild;
-                            isLeft = false;
-                        } else
-                        {
-                            successorParent->left = successorChild;
-                            isLeft = true;
-                        }
-                        if (successorChild != nullptr)
-                        {
-                            successorChild->parent = successorParent;
-                        }
-
-                        (*successorNode).~node_type();
-                        allocator.deallocate(successorNode, 1);
-
-                        --treeSize;
-
-                        if (removeColor == RBTColor::BLACK)
-                        {
-                            fix_delete(childNode, parentNode, isLeft);
-                        }
-                    }
-                }
+                erase_node(element.node);
             }
         }
 
         void clear()
         {
             clear_fun(rootNode);
+            release_slabs();
             treeSize = 0;
             rootNode = endNode;
             beginNode = endNode;
             endNode->parent = nullptr;
         }
 
-        void swap(RedBlackTree<TYPE, ALLOCATOR>& other)
+        void swap(RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other)
         {
             const auto tempSize = treeSize;
             const auto tempRoot = rootNode;
@@ -1919,9 +1134,14 @@ namespace bice
             other.rootNode = tempRoot;
             other.beginNode = tempBegin;
             other.endNode = tempEnd;
+
+            std::swap(allocator, other.allocator);
+            std::swap(compareFun, other.compareFun);
+            std::swap(slabList, other.slabList);
+            std::swap(freeNodes, other.freeNodes);
         }
 
-        [[nodiscard]] bool operator == (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator == (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal = true;
             if (treeSize == other.treeSize)
@@ -1946,7 +1166,7 @@ namespace bice
             return equal;
         }
 
-        [[nodiscard]] bool operator != (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator != (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal = false;
             if (treeSize == other.treeSize)
@@ -1971,7 +1191,7 @@ namespace bice
             return equal;
         }
 
-        [[nodiscard]] bool operator >= (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator >= (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal;
 
@@ -2047,7 +1267,7 @@ namespace bice
             return equal;
         }
 
-        [[nodiscard]] bool operator > (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator > (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal;
 
@@ -2122,7 +1342,7 @@ namespace bice
             return equal;
         }
 
-        [[nodiscard]] bool operator <= (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator <= (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal;
 
@@ -2199,7 +1419,7 @@ namespace bice
             return equal;
         }
 
-        [[nodiscard]] bool operator < (const RedBlackTree<TYPE, ALLOCATOR>& other) const noexcept
+        [[nodiscard]] bool operator < (const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other) const noexcept
         {
             bool equal;
 
@@ -2279,10 +1499,31 @@ namespace bice
     private:
 
         real_allocator_type allocator;
+        key_compare compareFun;
         size_type treeSize;
         node_pointer rootNode;
         node_pointer beginNode;
         node_pointer endNode;
+        node_pointer slabList;
+        node_pointer freeNodes;
+
+        struct slab_header
+        {
+            node_pointer next;
+            size_type count;
+        };
+
+        struct build_frame
+        {
+            size_type low;
+            size_type high;
+            size_type depth;
+            node_pointer parent;
+            bool left;
+        };
+
+        static_assert(sizeof(slab_header) <= sizeof(node_type) && alignof(slab_header) <= alignof(node_type),
+                      "Slab header must fit in a node");
 
         void print_tree(node_pointer node)
         {
@@ -2322,6 +1563,235 @@ namespace bice
             endNode = workNode;
         }
 
+        void ensure_end_node()
+        {
+            if (endNode == nullptr)
+            {
+                initEndNode();
+                beginNode = endNode;
+                rootNode = endNode;
+            }
+            if (endNode == nullptr)
+            {
+                throw std::out_of_range("Tree is not initialized");
+            }
+        }
+
+        template<typename K>
+        [[nodiscard]] node_pointer lower_bound_node(const K& value, node_pointer currentNode = nullptr) const
+        {
+            if (endNode == nullptr)
+            {
+                throw std::out_of_range("Tree is not initialized");
+            }
+
+            node_pointer candidateNode = endNode;
+            if (currentNode == nullptr)
+            {
+                currentNode = rootNode;
+            }
+            while (currentNode != nullptr && currentNode != endNode)
+            {
+                if (compareFun(currentNode->data, value))
+                {
+                    currentNode = currentNode->right;
+                } else
+                {
+                    candidateNode = currentNode;
+                    currentNode = currentNode->left;
+                }
+            }
+            return candidateNode;
+        }
+
+        template<typename K>
+        [[nodiscard]] node_pointer upper_bound_node(const K& value, node_pointer currentNode = nullptr) const
+        {
+            if (endNode == nullptr)
+            {
+                throw std::out_of_range("Tree is not initialized");
+            }
+
+            node_pointer candidateNode = endNode;
+            if (currentNode == nullptr)
+            {
+                currentNode = rootNode;
+            }
+            while (currentNode != nullptr && currentNode != endNode)
+            {
+                if (compareFun(value, currentNode->data))
+                {
+                    candidateNode = currentNode;
+                    currentNode = currentNode->left;
+                } else
+                {
+                    currentNode = currentNode->right;
+                }
+            }
+            return candidateNode;
+        }
+
+        template<typename K>
+        [[nodiscard]] node_pointer find_node(const K& value) const
+        {
+            node_pointer candidateNode = lower_bound_node(value);
+            if (candidateNode != endNode && !compareFun(value, candidateNode->data))
+            {
+                return candidateNode;
+            }
+            return endNode;
+        }
+
+        template<typename K>
+        [[nodiscard]] std::pair<node_pointer, node_pointer> equal_range_nodes(const K& value) const
+        {
+            if (endNode == nullptr)
+            {
+                throw std::out_of_range("Tree is not initialized");
+            }
+
+            node_pointer upperNode = endNode;
+            node_pointer currentNode = rootNode;
+            while (currentNode != nullptr && currentNode != endNode)
+            {
+                if (compareFun(currentNode->data, value))
+                {
+                    currentNode = currentNode->right;
+                } else if (compareFun(value, currentNode->data))
+                {
+                    upperNode = currentNode;
+                    currentNode = currentNode->left;
+                } else
+                {
+                    node_pointer lowerNode = lower_bound_node(value, currentNode->left);
+                    if (lowerNode == endNode)
+                    {
+                        lowerNode = currentNode;
+                    }
+                    node_pointer rightNode = currentNode->right;
+                    if (rightNode != nullptr && rightNode != endNode)
+                    {
+                        rightNode = upper_bound_node(value, rightNode);
+                        if (rightNode != endNode)
+                        {
+                            upperNode = rightNode;
+                        }
+                    }
+                    return std::pair<node_pointer, node_pointer>(lowerNode, upperNode);
+                }
+            }
+            return std::pair<node_pointer, node_pointer>(upperNode, upperNode);
+        }
+
+        template<typename K>
+        [[nodiscard]] std::pair<node_pointer, node_pointer> range_nodes(const K& low, const K& high) const
+        {
+            node_pointer firstNode = lower_bound_node(low);
+            if (firstNode == endNode || !compareFun(firstNode->data, high))
+            {
+                return std::pair<node_pointer, node_pointer>(endNode, endNode);
+            }
+            return std::pair<node_pointer, node_pointer>(firstNode, lower_bound_node(high));
+        }
+
+        template<typename K>
+        [[nodiscard]] node_pointer insert_position(const K& value, bool& insertLeft, node_pointer& equalNode) const
+        {
+            node_pointer parentNode{nullptr};
+            node_pointer lowerNode{nullptr};
+            node_pointer currentNode = rootNode;
+            insertLeft = true;
+            while (currentNode != nullptr && currentNode != endNode)
+            {
+                parentNode = currentNode;
+                insertLeft = compareFun(value, currentNode->data);
+                if (insertLeft)
+                {
+                    currentNode = currentNode->left;
+                } else
+                {
+                    lowerNode = currentNode;
+                    currentNode = currentNode->right;
+                }
+            }
+
+            equalNode = lowerNode != nullptr && !compareFun(lowerNode->data, value) ? lowerNode : nullptr;
+            return parentNode;
+        }
+
+        template<typename VALUE>
+        std::pair<iterator, bool> insert_value(VALUE&& value)
+        {
+            ensure_end_node();
+
+            bool insertLeft{true};
+            node_pointer equalNode{nullptr};
+            node_pointer parentNode = insert_position(value, insertLeft, equalNode);
+            if (equalNode != nullptr)
+            {
+                return std::pair<iterator, bool>(iterator(equalNode), false);
+            }
+
+            node_pointer workNode{nullptr};
+            try
+            {
+                workNode = acquire_node();
+                new(workNode) node_type{value_type(std::forward<VALUE>(value)), RBTColor::RED, nullptr, nullptr, nullptr};
+            } catch (std::bad_alloc)
+            {
+                return std::pair<iterator, bool>(iterator(endNode), false);
+            } catch (...)
+            {
+                release_node(workNode);
+                return std::pair<iterator, bool>(iterator(endNode), false);
+            }
+
+            attach_node(workNode, parentNode, insertLeft);
+            return std::pair<iterator, bool>(iterator(workNode), true);
+        }
+
+        bool insert_or_fail(const_reference value)
+        {
+            const std::pair<iterator, bool> result = insert_value(value);
+            return result.second || result.first.node != endNode;
+        }
+
+        void attach_node(node_pointer workNode, node_pointer parentNode, const bool insertLeft)
+        {
+            workNode->parent = parentNode;
+            if (parentNode == nullptr)
+            {
+                workNode->color = RBTColor::BLACK;
+                workNode->right = endNode;
+                endNode->parent = workNode;
+                rootNode = workNode;
+                beginNode = workNode;
+                treeSize = 1;
+                update_size(workNode);
+                return;
+            }
+
+            if (insertLeft)
+            {
+                parentNode->left = workNode;
+                if (parentNode == beginNode)
+                {
+                    beginNode = workNode;
+                }
+            } else
+            {
+                if (parentNode->right == endNode)
+                {
+                    workNode->right = endNode;
+                    endNode->parent = workNode;
+                }
+                parentNode->right = workNode;
+            }
+            ++treeSize;
+            update_path_sizes(workNode);
+            fix_insert(workNode);
+        }
+
         inline void left_rotate(node_pointer node)
         {
             node_pointer pivot = node->right;
@@ -2350,6 +1820,8 @@ namespace bice
             {
                 pivotLeft->parent = node;
             }
+            update_size(node);
+            update_size(pivot);
         }
 
         inline void right_rotate(node_pointer node)
@@ -2379,162 +1851,143 @@ namespace bice
             {
                 pivotRight->parent = node;
             }
+            update_size(node);
+            update_size(pivot);
         }
 
-        inline node_pointer get_grandfather(node_pointer node)
+        [[nodiscard]] inline size_type subtree_size(const_node_pointer node) const noexcept
         {
-            if (node->parent != nullptr)
-            {
-                return node->parent->parent;
-            } else
+            if constexpr (ORDER_STATISTICS)
             {
-                return nullptr;
+                if (node != nullptr && node != endNode)
+                {
+                    return node->size;
+                }
             }
+            return 0;
         }
 
-        inline node_pointer get_uncle(node_pointer node)
+        inline void update_size(node_pointer node) noexcept
         {
-            node_pointer grandfather = get_grandfather(node);
-
-            if (grandfather == nullptr)
+            if constexpr (ORDER_STATISTICS)
             {
-                return nullptr;
-            }
-            if (node->parent == grandfather->left)
-            {
-                return grandfather->right;
-            } else
-            {
-                return grandfather->left;
+                if (node != nullptr && node != endNode)
+                {
+                    node->size = 1 + subtree_size(node->left) + subtree_size(node->right);
+                }
             }
         }
 
-        inline node_pointer get_brother(node_pointer node)
+        inline void update_path_sizes(node_pointer node) noexcept
         {
-            if (node->parent != nullptr)
+            if constexpr (ORDER_STATISTICS)
             {
-                if (node == node->parent->left)
+                while (node != nullptr)
                 {
-                    return node->parent->right;
-                } else
-                {
-                    return node->parent->left;
+                    update_size(node);
+                    node = node->parent;
                 }
-            } else
-            {
-                return nullptr;
             }
         }
 
-        inline node_pointer get_brother_for_fix_delete(node_pointer node, node_pointer parent)
+        [[nodiscard]] node_pointer nth_node(size_type index) const
         {
-            if (node != nullptr)
-            {
-                return get_brother(node);
-            } else if ((parent->right == nullptr && parent->left == nullptr) ||
-            (parent->left == nullptr && parent->right == endNode))
-            {
-                return nullptr;
-            } else if ((parent->left != nullptr && parent->right == nullptr) ||
-            (parent->left != nullptr && parent->right == endNode))
+            if (endNode == nullptr)
             {
-                if (parent->left == node)
-                {
-                    return nullptr;
-                } else
-                {
-                    return parent->left;
-                }
-            } else if ((parent->left == nullptr && parent->right != nullptr) ||
-            (parent->left == nullptr && parent->right != endNode))
+                throw std::out_of_range("Tree is not initialized");
+            }
+
+            node_pointer currentNode = rootNode;
+            while (currentNode != nullptr && currentNode != endNode)
             {
-                if (parent->right == node)
+                const size_type leftSize = subtree_size(currentNode->left);
+                if (index < leftSize)
                 {
-                    return nullptr;
+                    currentNode = currentNode->left;
+                } else if (index == leftSize)
+                {
+                    return currentNode;
                 } else
                 {
-                    return parent->right;
+                    index -= leftSize + 1;
+                    currentNode = currentNode->right;
                 }
             }
-
-            return nullptr;
+            return endNode;
         }
 
-        inline bool is_node_left_child(node_pointer node)
+        template<typename K>
+        [[nodiscard]] size_type rank_node(const K& value) const
         {
-            if (node->parent != nullptr)
+            size_type position{0};
+            node_pointer currentNode = rootNode;
+            while (currentNode != nullptr && currentNode != endNode)
             {
-                node_pointer parent = node->parent;
-                if (parent->left == node)
+                if (compareFun(currentNode->data, value))
                 {
-                    return true;
+                    position += subtree_size(currentNode->left) + 1;
+                    currentNode = currentNode->right;
                 } else
                 {
-                    return false;
+                    currentNode = currentNode->left;
                 }
-            } else
-            {
-                return false;
             }
+            return position;
         }
 
-        inline bool is_node_right_child(node_pointer node)
+        inline node_pointer get_grandfather(node_pointer node)
         {
             if (node->parent != nullptr)
             {
-                node_pointer parent = node->parent;
-                if (parent->left == node)
-                {
-                    return false;
-                } else
-                {
-                    return true;
-                }
+                return node->parent->parent;
             } else
             {
-                return false;
+                return nullptr;
             }
         }
 
-        inline bool is_brother_childs_black(node_pointer brother)
+        inline node_pointer get_uncle(node_pointer node)
         {
-            RBTColor leftChildColor;
-            RBTColor rightChildColor;
+            node_pointer grandfather = get_grandfather(node);
 
-            if (brother != nullptr)
+            if (grandfather == nullptr)
             {
-                if (brother->left != nullptr)
-                {
-                    leftChildColor = brother->left->color;
-                } else
-                {
-                    leftChildColor = RBTColor::BLACK;
-                }
+                return nullptr;
+            }
+            if (node->parent == grandfather->left)
+            {
+                return grandfather->right;
+            } else
+            {
+                return grandfather->left;
+            }
+        }
 
-                if (brother->right != nullptr)
+        inline node_pointer get_brother(node_pointer node)
+        {
+            if (node->parent != nullptr)
+            {
+                if (node == node->parent->left)
                 {
-                    rightChildColor = brother->right->color;
+                    return node->parent->right;
                 } else
                 {
-                    rightChildColor = RBTColor::BLACK;
+                    return node->parent->left;
                 }
             } else
             {
-                return false;
+                return nullptr;
             }
-
-            return leftChildColor == RBTColor::BLACK && rightChildColor == RBTColor::BLACK;
         }
 
-        inline bool is_brother_right_child_black(node_pointer brotherNode)
+        inline bool is_node_left_child(node_pointer node)
         {
-            RBTColor rightChildColor = RBTColor::BLACK;
-
-            if (brotherNode != nullptr)
+            if (node->parent != nullptr)
             {
-                if (brotherNode->right != nullptr)
+                node_pointer parent = node->parent;
+                if (parent->left == node)
                 {
-                    rightChildColor = brotherNode->right->color;
+                    return true;
                 } else
                 {
                     return false;
@@ -2543,29 +1996,24 @@ namespace bice
             {
                 return false;
             }
-
-            return rightChildColor == RBTColor::BLACK;
         }
 
-        inline bool is_brother_left_child_black(node_pointer brotherNode)
+        inline bool is_node_right_child(node_pointer node)
         {
-            RBTColor leftChildColor = RBTColor::BLACK;
-
-            if (brotherNode != nullptr)
+            if (node->parent != nullptr)
             {
-                if (brotherNode->left != nullptr)
+                node_pointer parent = node->parent;
+                if (parent->left == node)
                 {
-                    leftChildColor = brotherNode->left->color;
+                    return false;
                 } else
                 {
-                    return false;
+                    return true;
                 }
             } else
             {
                 return false;
             }
-
-            return leftChildColor == RBTColor::BLACK;
         }
 
         void fix_insert(node_pointer node)
@@ -2580,7 +2028,7 @@ namespace bice
                 node_pointer nodeUncle{nullptr};
                 node_pointer grandfatherNode{nullptr};
 
-                while (nodeParent != nullptr && nodeParent->color == RBTColor::RED)
+                while (node != rootNode && node->parent->color == RBTColor::RED)
                 {
                     nodeParent = node->parent;
                     nodeUncle = get_uncle(node);
@@ -2634,125 +2082,184 @@ namespace bice
             }
         }
 
-        void fix_delete(node_pointer childNode, node_pointer parentNode, bool leftChild)
+        [[nodiscard]] static inline bool is_black(const_node_pointer node) noexcept
         {
-            node_pointer currentNode{nullptr};
-            node_pointer brotherNode{nullptr};
-            node_type nil{value_type(), RBTColor::BLACK, parentNode, nullptr, nullptr};
-            bool isNilActivate = false;
-            if (childNode == nullptr)
+            return node == nullptr || node->color == RBTColor::BLACK;
+        }
+
+        inline void transplant(node_pointer oldNode, node_pointer newNode) noexcept
+        {
+            node_pointer parentNode = oldNode->parent;
+            if (parentNode == nullptr)
+            {
+                rootNode = newNode;
+            } else if (parentNode->left == oldNode)
+            {
+                parentNode->left = newNode;
+            } else
+            {
+                parentNode->right = newNode;
+            }
+
+            if (newNode != nullptr)
+            {
+                newNode->parent = parentNode;
+            }
+        }
+
+        void erase_node(node_pointer removeNode)
+        {
+            node_pointer maximumNode = endNode->parent;
+            maximumNode->right = nullptr;
+            endNode->parent = nullptr;
+
+            node_pointer childNode{nullptr};
+            node_pointer parentNode{nullptr};
+            RBTColor removeColor = removeNode->color;
+            if (removeNode->left == nullptr)
             {
-                if (leftChild)
+                childNode = removeNode->right;
+                parentNode = removeNode->parent;
+                transplant(removeNode, childNode);
+            } else if (removeNode->right == nullptr)
+            {
+                childNode = removeNode->left;
+                parentNode = removeNode->parent;
+                transplant(removeNode, childNode);
+            } else
+            {
+                node_pointer successorNode = removeNode->right;
+                while (successorNode->left != nullptr)
+                {
+                    successorNode = successorNode->left;
+                }
+
+                removeColor = successorNode->color;
+                childNode = successorNode->right;
+                if (successorNode->parent == removeNode)
                 {
-                    parentNode->left = &nil;
+                    parentNode = successorNode;
                 } else
                 {
-                    parentNode->right = &nil;
+                    parentNode = successorNode->parent;
+                    transplant(successorNode, childNode);
+                    successorNode->right = removeNode->right;
+                    successorNode->right->parent = successorNode;
                 }
-                isNilActivate = true;
-                currentNode = &nil;
-            } else
+
+                transplant(removeNode, successorNode);
+                successorNode->left = removeNode->left;
+                successorNode->left->parent = successorNode;
+                successorNode->color = removeNode->color;
+            }
+
+            (*removeNode).~node_type();
+            release_node(removeNode);
+            --treeSize;
+            update_path_sizes(parentNode);
+
+            if (removeColor == RBTColor::BLACK)
+            {
+                fix_delete(childNode, parentNode);
+            }
+
+            if (treeSize == 0)
+            {
+                rootNode = endNode;
+                beginNode = endNode;
+                return;
+            }
+
+            maximumNode = rootNode;
+            while (maximumNode->right != nullptr)
+            {
+                maximumNode = maximumNode->right;
+            }
+            maximumNode->right = endNode;
+            endNode->parent = maximumNode;
+
+            beginNode = rootNode;
+            while (beginNode->left != nullptr)
             {
-                currentNode = childNode;
+                beginNode = beginNode->left;
             }
+        }
 
-            while (currentNode != rootNode && currentNode->color == RBTColor::BLACK)
+        void fix_delete(node_pointer currentNode, node_pointer parentNode)
+        {
+            node_pointer brotherNode{nullptr};
+            while (currentNode != rootNode && is_black(currentNode))
             {
-                if (currentNode->parent->left == currentNode)
+                if (parentNode->left == currentNode)
                 {
-                    brotherNode = currentNode->parent->right;
-                    if (brotherNode != nullptr && brotherNode->color == RBTColor::RED)
+                    brotherNode = parentNode->right;
+                    if (brotherNode->color == RBTColor::RED)
                     {
                         brotherNode->color = RBTColor::BLACK;
-                        currentNode->parent->color = RBTColor::RED;
-                        left_rotate(currentNode->parent);
-                        brotherNode = currentNode->parent->right;
+                        parentNode->color = RBTColor::RED;
+                        left_rotate(parentNode);
+                        brotherNode = parentNode->right;
                     }
 
-                    if (is_brother_childs_black(brotherNode))
+                    if (is_black(brotherNode->left) && is_black(brotherNode->right))
                     {
                         brotherNode->color = RBTColor::RED;
-                        currentNode = currentNode->parent;
+                        currentNode = parentNode;
+                        parentNode = currentNode->parent;
                     } else
                     {
-                        if (is_brother_right_child_black(brotherNode))
+                        if (is_black(brotherNode->right))
                         {
-                            if (brotherNode->left != nullptr)
-                            {
-                                brotherNode->left->color = RBTColor::BLACK;
-                            }
+                            brotherNode->left->color = RBTColor::BLACK;
                             brotherNode->color = RBTColor::RED;
                             right_rotate(brotherNode);
-                            brotherNode = currentNode->parent->right;
+                            brotherNode = parentNode->right;
                         }
 
-                        if (brotherNode != nullptr)
-                        {
-                            brotherNode->color = currentNode->parent->color;
-                            if (brotherNode->right != nullptr)
-                            {
-                                brotherNode->right->color = RBTColor::BLACK;
-                            }
-                        }
-                        currentNode->parent->color = RBTColor::BLACK;
-                        left_rotate(currentNode->parent);
+                        brotherNode->color = parentNode->color;
+                        parentNode->color = RBTColor::BLACK;
+                        brotherNode->right->color = RBTColor::BLACK;
+                        left_rotate(parentNode);
                         currentNode = rootNode;
                     }
                 } else
                 {
-                    brotherNode = currentNode->parent->left;
-                    if (brotherNode != nullptr && brotherNode->color == RBTColor::RED)
+                    brotherNode = parentNode->left;
+                    if (brotherNode->color == RBTColor::RED)
                     {
                         brotherNode->color = RBTColor::BLACK;
-                        currentNode->parent->color = RBTColor::RED;
-                        right_rotate(currentNode->parent);
-                        brotherNode = currentNode->parent->left;
+                        parentNode->color = RBTColor::RED;
+                        right_rotate(parentNode);
+                        brotherNode = parentNode->left;
                     }
 
-                    if (is_brother_childs_black(brotherNode))
+                    if (is_black(brotherNode->left) && is_black(brotherNode->right))
                     {
                         brotherNode->color = RBTColor::RED;
-                        currentNode = currentNode->parent;
+                        currentNode = parentNode;
+                        parentNode = currentNode->parent;
                     } else
                     {
-                        if (is_brother_left_child_black(brotherNode))
+                        if (is_black(brotherNode->left))
                         {
-                            if (brotherNode->right != nullptr)
-                            {
-                                brotherNode->right->color = RBTColor::BLACK;
-                            }
+                            brotherNode->right->color = RBTColor::BLACK;
                             brotherNode->color = RBTColor::RED;
                             left_rotate(brotherNode);
-                            brotherNode = currentNode->parent->left;
+                            brotherNode = parentNode->left;
                         }
 
-                        if (brotherNode != nullptr)
-                        {
-                            brotherNode->color = currentNode->parent->color;
-                            if (brotherNode->left != nullptr)
-                            {
-                                brotherNode->left->color = RBTColor::BLACK;
-                            }
-                        }
-                        currentNode->parent->color = RBTColor::BLACK;
-                        right_rotate(currentNode->parent);
+                        brotherNode->color = parentNode->color;
+                        parentNode->color = RBTColor::BLACK;
+                        brotherNode->left->color = RBTColor::BLACK;
+                        right_rotate(parentNode);
                         currentNode = rootNode;
                     }
                 }
             }
 
-            currentNode->color = RBTColor::BLACK;
-
-            if (isNilActivate)
+            if (currentNode != nullptr)
             {
-                node_pointer parent = nil.parent;
-                if (parent->left == &nil)
-                {
-                    parent->left = nullptr;
-                } else
-                {
-                    parent->right = nullptr;
-                }
+                currentNode->color = RBTColor::BLACK;
             }
         }
 
@@ -2763,7 +2270,7 @@ namespace bice
                 clear_fun(node->left);
                 clear_fun(node->right);
                 (*node).~node_type();
-                allocator.deallocate(node, 1);
+                release_node(node);
             }
         }
 
@@ -2774,18 +2281,264 @@ namespace bice
                 clear_destructor(node->left);
                 clear_destructor(node->right);
                 (*node).~node_type();
-                allocator.deallocate(node, 1);
+                release_node(node);
+            }
+        }
+
+        [[nodiscard]] inline slab_header* slab_of(node_pointer slab) const noexcept
+        {
+            return std::launder(reinterpret_cast<slab_header*>(slab));
+        }
+
+        [[nodiscard]] node_pointer allocate_slab(const size_type count)
+        {
+            node_pointer slab = allocator.allocate(count + 1);
+            ::new(static_cast<void*>(slab)) slab_header{slabList, count};
+            slabList = slab;
+            return slab + 1;
+        }
+
+        void release_slabs() noexcept
+        {
+            while (slabList != nullptr)
+            {
+                node_pointer nextSlab = slab_of(slabList)->next;
+                allocator.deallocate(slabList, slab_of(slabList)->count + 1);
+                slabList = nextSlab;
+            }
+            freeNodes = nullptr;
+        }
+
+        [[nodiscard]] bool is_slab_node(const_node_pointer node) const noexcept
+        {
+            for (node_pointer slab = slabList; slab != nullptr; slab = slab_of(slab)->next)
+            {
+                if (!std::less<const_node_pointer>()(node, slab + 1) &&
+                    std::less<const_node_pointer>()(node, slab + 1 + slab_of(slab)->count))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] node_pointer acquire_node()
+        {
+            if (freeNodes != nullptr)
+            {
+                node_pointer node = freeNodes;
+                freeNodes = *std::launder(reinterpret_cast<node_pointer*>(node));
+                return node;
+            }
+            return allocator.allocate(1);
+        }
+
+        void release_node(node_pointer node) noexcept
+        {
+            if (slabList != nullptr && is_slab_node(node))
+            {
+                ::new(static_cast<void*>(node)) node_pointer(freeNodes);
+                freeNodes = node;
+                return;
+            }
+            allocator.deallocate(node, 1);
+        }
+
+        [[nodiscard]] inline node_pointer clone_node(const_node_pointer source, node_pointer target, node_pointer parent)
+        {
+            new(target) node_type{value_type(source->data), source->color, parent, nullptr, nullptr};
+            if constexpr (ORDER_STATISTICS)
+            {
+                target->size = source->size;
+            }
+            return target;
+        }
+
+        void link_end_node(node_pointer copyRoot)
+        {
+            node_pointer minimumNode = copyRoot;
+            while (minimumNode->left != nullptr)
+            {
+                minimumNode = minimumNode->left;
+            }
+
+            node_pointer maximumNode = copyRoot;
+            while (maximumNode->right != nullptr)
+            {
+                maximumNode = maximumNode->right;
+            }
+
+            maximumNode->right = endNode;
+            endNode->parent = maximumNode;
+            rootNode = copyRoot;
+            beginNode = minimumNode;
+        }
+
+        template<typename ITERATOR> requires std::forward_iterator<ITERATOR>
+        void build_sorted(const ITERATOR begin, const ITERATOR end)
+        {
+            ensure_end_node();
+            if (begin == end)
+            {
+                return;
+            }
+
+            size_type count{1};
+            bool sorted{true};
+            ITERATOR previous = begin;
+            for (ITERATOR iter = std::next(begin); iter != end; previous = iter, ++iter)
+            {
+                if (compareFun(*previous, *iter))
+                {
+                    ++count;
+                } else if (compareFun(*iter, *previous))
+                {
+                    sorted = false;
+                    break;
+                }
+            }
+
+            if (!sorted)
+            {
+                for (ITERATOR iter = begin; iter != end; ++iter)
+                {
+                    push(*iter);
+                }
+                return;
+            }
+
+            node_pointer nodes{nullptr};
+            try
+            {
+                nodes = allocate_slab(count);
+            } catch (std::bad_alloc)
+            {
+                return;
+            }
+
+            size_type built{0};
+            try
+            {
+                for (ITERATOR iter = begin; iter != end; ++iter)
+                {
+                    if (built == 0 || compareFun(nodes[built - 1].data, *iter))
+                    {
+                        new(nodes + built) node_type{value_type(*iter), RBTColor::BLACK, nullptr, nullptr, nullptr};
+                        ++built;
+                    }
+                }
+            } catch (...)
+            {
+                while (built > 0)
+                {
+                    --built;
+                    nodes[built].~node_type();
+                }
+                release_slabs();
+                return;
+            }
+
+            size_type redDepth{0};
+            for (size_type remaining = count; remaining > 1; remaining >>= 1)
+            {
+                ++redDepth;
+            }
+
+            build_frame frames[2 * std::numeric_limits<size_type>::digits];
+            size_type frameCount{0};
+            frames[frameCount++] = build_frame{0, count, 0, nullptr, true};
+            while (frameCount > 0)
+            {
+                const build_frame frame = frames[--frameCount];
+                const size_type middle = frame.low + (frame.high - frame.low) / 2;
+                node_pointer workNode = nodes + middle;
+
+                workNode->parent = frame.parent;
+                if (frame.depth == redDepth && redDepth > 0)
+                {
+                    workNode->color = RBTColor::RED;
+                }
+                if constexpr (ORDER_STATISTICS)
+                {
+                    workNode->size = frame.high - frame.low;
+                }
+
+                if (frame.parent == nullptr)
+                {
+                    rootNode = workNode;
+                } else if (frame.left)
+                {
+                    frame.parent->left = workNode;
+                } else
+                {
+                    frame.parent->right = workNode;
+                }
+
+                if (middle + 1 < frame.high)
+                {
+                    frames[frameCount++] = build_frame{middle + 1, frame.high, frame.depth + 1, workNode, false};
+                }
+                if (frame.low < middle)
+                {
+                    frames[frameCount++] = build_frame{frame.low, middle, frame.depth + 1, workNode, true};
+                }
             }
+
+            beginNode = nodes;
+            nodes[count - 1].right = endNode;
+            endNode->parent = nodes + count - 1;
+            treeSize = count;
         }
 
-        void copy_fun(node_pointer node, node_pointer stop)
+        void copy_tree(const RedBlackTree<TYPE, COMPARE, ALLOCATOR, ORDER_STATISTICS>& other)
         {
-            if (node != nullptr && node != stop)
+            ensure_end_node();
+
+            node_pointer nextNode{nullptr};
+            try
+            {
+                nextNode = allocate_slab(other.treeSize);
+            } catch (std::bad_alloc)
+            {
+                return;
+            }
+
+            node_pointer sourceNode = other.rootNode;
+            node_pointer copyRoot{nullptr};
+            try
+            {
+                copyRoot = clone_node(sourceNode, nextNode++, nullptr);
+                node_pointer copyNode = copyRoot;
+                while (true)
+                {
+                    if (sourceNode->left != nullptr && copyNode->left == nullptr)
+                    {
+                        sourceNode = sourceNode->left;
+                        copyNode->left = clone_node(sourceNode, nextNode++, copyNode);
+                        copyNode = copyNode->left;
+                    } else if (sourceNode->right != nullptr && sourceNode->right != other.endNode && copyNode->right == nullptr)
+                    {
+                        sourceNode = sourceNode->right;
+                        copyNode->right = clone_node(sourceNode, nextNode++, copyNode);
+                        copyNode = copyNode->right;
+                    } else if (sourceNode != other.rootNode)
+                    {
+                        sourceNode = sourceNode->parent;
+                        copyNode = copyNode->parent;
+                    } else
+                    {
+                        break;
+                    }
+                }
+            } catch (...)
             {
-                push(std::forward<const_reference>(node->data));
-                copy_fun(node->left, stop);
-                copy_fun(node->right, stop);
+                clear_fun(copyRoot);
+                release_slabs();
+                return;
             }
+
+            link_end_node(copyRoot);
+            treeSize = other.treeSize;
         }
     };
 }
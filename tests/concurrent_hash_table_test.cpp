@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+#include "../Collections/concurrent_hash_table.h"
+
+namespace
+{
+
+    template<typename TYPE>
+    struct FailingAllocator
+    {
+        using value_type = TYPE;
+
+        FailingAllocator() noexcept = default;
+
+        template<typename OTHER>
+        FailingAllocator(const FailingAllocator<OTHER>&) noexcept {}
+
+        TYPE* allocate(const std::size_t)
+        {
+            throw std::bad_alloc();
+        }
+
+        void deallocate(TYPE*, const std::size_t) noexcept {}
+
+        template<typename OTHER>
+        bool operator == (const FailingAllocator<OTHER>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    void single_thread()
+    {
+        bice::ConcurrentHashTable<int, int> table(4);
+        for(int key = 0; key < 1000; ++key)
+        {
+            assert(table.insert(key, key));
+        }
+        assert(!table.insert(0, 1));
+        assert(table.size() == 1000);
+        assert(table.find(10).value() == 10);
+        assert(!table.find(1000).has_value());
+
+        assert(!table.insert_or_assign(10, 11));
+        assert(table.update(10, [](int& value) { ++value; }));
+        assert(table.find(10).value() == 12);
+        assert(table.compute_if_absent(2000, [](const int key) { return key + 1; }) == 2001);
+        assert(table.compute_if_absent(2000, [](const int) { return 0; }) == 2001);
+
+        for(int key = 0; key < 1000; key += 2)
+        {
+            assert(table.erase(key));
+        }
+        assert(!table.erase(0));
+        assert(table.size() == 501);
+
+        std::uint64_t visited{0};
+        table.for_each([&visited](const std::pair<int, int>&) { ++visited; });
+        assert(visited == table.size());
+
+        table.clear();
+        assert(table.empty());
+        assert(!table.contains(1));
+    }
+
+    void constructor_throws_without_memory()
+    {
+        using table_type = bice::ConcurrentHashTable<int, int, std::hash<int>, std::equal_to<int>,
+                FailingAllocator<bice::HashNode<std::pair<int, int>, true>*>>;
+        bool thrown = false;
+        try
+        {
+            table_type table(4);
+        } catch (const std::bad_alloc&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    void concurrent_insert_find_erase()
+    {
+        constexpr int threadCount = 4;
+        constexpr int keysPerThread = 20000;
+
+        bice::ConcurrentHashTable<int, int> table(8, 16);
+        std::vector<std::thread> threads;
+        for(int thread = 0; thread < threadCount; ++thread)
+        {
+            threads.emplace_back([&table, thread]()
+            {
+                const int first = thread * keysPerThread;
+                for(int key = first; key < first + keysPerThread; ++key)
+                {
+                    assert(table.insert(key, key * 2));
+                    const int other = (key * 7) % (threadCount * keysPerThread);
+                    const auto value = table.find(other);
+                    assert(!value.has_value() || *value == other * 2);
+                }
+                for(int key = first; key < first + keysPerThread; key += 2)
+                {
+                    assert(table.erase(key));
+                }
+            });
+        }
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        assert(table.size() == (std::uint64_t)(threadCount * keysPerThread / 2));
+        for(int key = 0; key < threadCount * keysPerThread; ++key)
+        {
+            assert(table.contains(key) == (key % 2 == 1));
+        }
+    }
+
+}
+
+int main()
+{
+    single_thread();
+    constructor_throws_without_memory();
+    concurrent_insert_find_erase();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../Collections/flat_hash_table.h"
+
+namespace
+{
+
+    struct ConstantHash
+    {
+        std::size_t operator () (const int) const noexcept
+        {
+            return 0;
+        }
+    };
+
+    void insert_find_remove_iterate()
+    {
+        bice::FlatHashTable<int, int> table;
+        for(int key = 0; key < 1000; ++key)
+        {
+            assert(table.insert(std::pair<int, int>(key, key * 2)).second);
+        }
+        assert(!table.insert(std::pair<int, int>(0, 1)).second);
+        assert(table.size() == 1000);
+        assert((*table.find(10)).second == 20);
+        assert(table.find(1000) == table.end());
+
+        for(int key = 0; key < 1000; key += 2)
+        {
+            table.remove(key);
+        }
+        assert(table.size() == 500);
+
+        std::vector<int> seen(1000, 0);
+        for(const auto& value : table)
+        {
+            assert(value.first % 2 == 1);
+            assert(value.second == value.first * 2);
+            ++seen[(std::size_t)value.first];
+        }
+        for(int key = 0; key < 1000; ++key)
+        {
+            assert(seen[(std::size_t)key] == key % 2);
+            assert(table.contains(key) == (key % 2 == 1));
+        }
+
+        const bice::FlatHashTable<int, int> copy(table);
+        assert(copy == table);
+        table.clear();
+        assert(table.empty());
+        assert(copy.size() == 500);
+    }
+
+    void tombstone_reuse()
+    {
+        constexpr int keyCount = 20;
+
+        bice::FlatHashTable<int, int, ConstantHash> table(keyCount);
+        const std::uint64_t capacity = table.capacity();
+        for(int key = 0; key < keyCount; ++key)
+        {
+            assert(table.insert(std::pair<int, int>(key, key)).second);
+        }
+
+        const std::uint64_t removedIndex = table.find(0).get_index();
+        table.remove(0);
+        assert(!table.contains(0));
+        for(int key = 1; key < keyCount; ++key)
+        {
+            assert(table.contains(key));
+        }
+
+        const auto result = table.insert(std::pair<int, int>(keyCount, keyCount));
+        assert(result.second);
+        assert(result.first.get_index() == removedIndex);
+        assert(table.capacity() == capacity);
+        assert(table.size() == (std::uint64_t)keyCount);
+    }
+
+    void churn_keeps_capacity()
+    {
+        bice::FlatHashTable<int, int> table(64);
+        const std::uint64_t capacity = table.capacity();
+        for(int key = 0; key < 100000; ++key)
+        {
+            assert(table.insert(std::pair<int, int>(key, key)).second);
+            if (key >= 32)
+            {
+                table.remove(key - 32);
+            }
+        }
+        assert(table.size() == 32);
+        assert(table.capacity() == capacity);
+        for(int key = 100000 - 32; key < 100000; ++key)
+        {
+            assert(table.contains(key));
+        }
+    }
+
+}
+
+int main()
+{
+    insert_find_remove_iterate();
+    tombstone_reuse();
+    churn_keeps_capacity();
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../Collections/hash_table.h"
+#include "../Collections/frozen_hash_table.h"
+
+namespace
+{
+
+    struct HalfHash
+    {
+        std::uint64_t operator () (const int key) const noexcept
+        {
+            return (std::uint64_t)(key / 2);
+        }
+    };
+
+    void lookup()
+    {
+        std::vector<std::pair<int, int>> values;
+        for(int key = 0; key < 1000; ++key)
+        {
+            values.emplace_back(key, key * 3);
+        }
+
+        const bice::FrozenHashTable<int, int> table(values.begin(), values.end());
+        assert(table.size() == 1000);
+        assert(table.key_span().size() == 1000);
+        for(int key = 0; key < 1000; ++key)
+        {
+            assert(table.contains(key));
+            assert(table.at(key) == key * 3);
+        }
+        assert(table.find(1000) == nullptr);
+        assert(table.find(-1) == nullptr);
+    }
+
+    void freeze_multimap()
+    {
+        bice::HashTable<int, int> source;
+        for(int copy = 0; copy < 3; ++copy)
+        {
+            for(int key = 0; key < 200; ++key)
+            {
+                source.insert(std::pair<int, int>(key, key));
+            }
+        }
+        assert(source.size() == 600);
+
+        const auto frozen = source.freeze();
+        assert(frozen.size() == 200);
+        for(int key = 0; key < 200; ++key)
+        {
+            assert(frozen.at(key) == key);
+        }
+        assert(!frozen.contains(200));
+    }
+
+    void colliding_hashes()
+    {
+        std::vector<std::pair<int, int>> values;
+        for(int key = 0; key < 500; ++key)
+        {
+            values.emplace_back(key, -key);
+        }
+        values.emplace_back(7, 0);
+
+        const bice::FrozenHashTable<int, int, HalfHash> table(values.begin(), values.end());
+        assert(table.size() == 500);
+        for(int key = 0; key < 500; ++key)
+        {
+            assert(table.at(key) == -key);
+        }
+        assert(table.find(500) == nullptr);
+        assert(table.find(501) == nullptr);
+
+        const bice::FrozenHashTable<int, int, HalfHash> copy(table);
+        assert(copy.size() == 500);
+        for(int key = 0; key < 500; ++key)
+        {
+            assert(copy.at(key) == -key);
+        }
+    }
+
+}
+
+int main()
+{
+    lookup();
+    freeze_multimap();
+    colliding_hashes();
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include "../Collections/hash_functions.h"
+#include "../Collections/hash_table.h"
+#include "../Collections/hash_table_snapshot.h"
+
+namespace
+{
+
+    using table_type = bice::HashTable<int, int, bice::IntegerHash>;
+    using snapshot_type = bice::HashTableSnapshot<int, int, bice::IntegerHash>;
+
+    std::string snapshot_path()
+    {
+        return (std::filesystem::temp_directory_path() / "bice_hash_table_snapshot_test.bin").string();
+    }
+
+    table_type make_table(const std::uint64_t seed)
+    {
+        table_type table(16, bice::IntegerHash(seed));
+        for(int key = 0; key < 1000; ++key)
+        {
+            table.insert(std::pair<int, int>(key, key * 2));
+        }
+        return table;
+    }
+
+    void check_lookup(const snapshot_type& snapshot)
+    {
+        assert(snapshot.is_open());
+        assert(snapshot.size() == 1000);
+        for(int key = 0; key < 1000; ++key)
+        {
+            const int* value = snapshot.find(key);
+            assert(value != nullptr && *value == key * 2);
+        }
+        assert(!snapshot.contains(1000));
+        assert(!snapshot.contains(-1));
+    }
+
+    void save_and_open()
+    {
+        const std::string path = snapshot_path();
+        const table_type table = make_table(42);
+        assert(snapshot_type::save(table, path, bice::IntegerHash(42)));
+
+        snapshot_type snapshot(bice::IntegerHash(42));
+        assert(snapshot.open(path));
+        check_lookup(snapshot);
+
+        snapshot_type moved(std::move(snapshot));
+        assert(!snapshot.is_open());
+        check_lookup(moved);
+        moved.close();
+        std::remove(path.c_str());
+    }
+
+    void save_with_other_hasher()
+    {
+        const std::string path = snapshot_path();
+        const table_type table = make_table(42);
+        assert(snapshot_type::save(table, path, bice::IntegerHash(7)));
+
+        snapshot_type snapshot(bice::IntegerHash(7));
+        assert(snapshot.open(path));
+        check_lookup(snapshot);
+        snapshot.close();
+        std::remove(path.c_str());
+    }
+
+    void reject_hasher_mismatch()
+    {
+        const std::string path = snapshot_path();
+        const table_type table = make_table(42);
+        assert(snapshot_type::save(table, path, bice::IntegerHash(42)));
+
+        snapshot_type snapshot(bice::IntegerHash(7));
+        assert(!snapshot.open(path));
+        assert(!snapshot.is_open());
+        std::remove(path.c_str());
+    }
+
+}
+
+int main()
+{
+    save_and_open();
+    save_with_other_hasher();
+    reject_hasher_mismatch();
+    return 0;
+}
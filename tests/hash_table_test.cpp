@@ -0,0 +1,115 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../Collections/hash_table.h"
+
+namespace
+{
+
+    void bulk_insert_during_incremental_rehash(const std::uint64_t threadCount)
+    {
+        constexpr int keyCount = 40;
+        constexpr int seedCopies = 4;
+        constexpr int bulkCopies = 1000;
+
+        bice::HashTable<int, int> table;
+        table.set_rehash_step(1);
+        for(int copy = 0; copy < seedCopies; ++copy)
+        {
+            for(int key = 0; key < keyCount; ++key)
+            {
+                table.insert(std::pair<int, int>(key, copy));
+            }
+        }
+
+        std::vector<std::pair<int, int>> values;
+        for(int idx = 0; idx < keyCount * bulkCopies; ++idx)
+        {
+            values.emplace_back(idx % keyCount, idx);
+        }
+        table.insert(values.begin(), values.end(), threadCount);
+
+        assert(!table.rehashing());
+        assert(table.size() == (std::uint64_t)(keyCount * (seedCopies + bulkCopies)));
+        for(int key = 0; key < keyCount; ++key)
+        {
+            assert(table.count(key) == (std::uint64_t)(seedCopies + bulkCopies));
+        }
+    }
+
+    void const_access_during_rehash()
+    {
+        bice::HashTable<int, int> table;
+        table.set_rehash_step(1);
+        int keyCount = 0;
+        while (!table.rehashing() || keyCount < 100)
+        {
+            table.insert(std::pair<int, int>(keyCount, keyCount));
+            ++keyCount;
+        }
+
+        const bice::HashTable<int, int>& constTable = table;
+        std::vector<int> seen((std::size_t)keyCount, 0);
+        for(auto iter = constTable.cbegin(); iter != constTable.cend(); ++iter)
+        {
+            ++seen[(std::size_t)(*iter).first];
+        }
+        for(const auto& value : constTable.view())
+        {
+            ++seen[(std::size_t)value.first];
+        }
+        for(const int count : seen)
+        {
+            assert(count == 2);
+        }
+        assert(table.rehashing());
+
+        const bice::HashTable<int, int> copy(constTable);
+        assert(table.rehashing());
+        assert(copy.size() == (std::uint64_t)keyCount);
+        for(int key = 0; key < keyCount; ++key)
+        {
+            assert(copy.count(key) == 1);
+        }
+
+        bice::HashTable<int, int> assigned;
+        assigned = constTable;
+        assert(table.rehashing());
+        assert(assigned.size() == (std::uint64_t)keyCount);
+        for(int key = 0; key < keyCount; ++key)
+        {
+            assert(assigned.count(key) == 1);
+        }
+    }
+
+    void self_assignment()
+    {
+        bice::HashTable<int, int> table;
+        for(int key = 0; key < 100; ++key)
+        {
+            table.insert(std::pair<int, int>(key, key));
+        }
+
+        bice::HashTable<int, int>& alias = table;
+        table = alias;
+        assert(table.size() == 100);
+        table = std::move(alias);
+        assert(table.size() == 100);
+        for(int key = 0; key < 100; ++key)
+        {
+            assert(table.count(key) == 1);
+        }
+    }
+
+}
+
+int main()
+{
+    bulk_insert_during_incremental_rehash(1);
+    bulk_insert_during_incremental_rehash(4);
+    self_assignment();
+    const_access_during_rehash();
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Collections/lru_cache.h"
+
+namespace
+{
+
+    struct LengthWeight
+    {
+        std::uint64_t operator () (const int, const std::string& value) const noexcept
+        {
+            return value.size();
+        }
+    };
+
+    void lru_evicts_by_count()
+    {
+        bice::LruCache<int, int> cache(3);
+        assert(cache.put(1, 10));
+        assert(cache.put(2, 20));
+        assert(cache.put(3, 30));
+        assert(cache.get(1) != nullptr);
+
+        assert(cache.put(4, 40));
+        assert(cache.size() == 3);
+        assert(!cache.contains(2));
+        assert(*cache.peek(1) == 10);
+        assert(*cache.peek(3) == 30);
+        assert(*cache.peek(4) == 40);
+
+        assert(cache.put(3, 31));
+        assert(cache.put(5, 50));
+        assert(cache.size() == 3);
+        assert(!cache.contains(1));
+        assert(*cache.get(3) == 31);
+
+        assert(cache.erase(3));
+        assert(!cache.erase(3));
+        assert(cache.size() == 2);
+
+        cache.set_limits(1);
+        assert(cache.size() == 1);
+        assert(cache.contains(5));
+    }
+
+    void lru_evicts_by_bytes()
+    {
+        bice::LruCache<int, std::string, std::hash<int>, std::equal_to<int>, LengthWeight> cache(100, 10);
+        assert(cache.put(1, std::string(4, 'a')));
+        assert(cache.put(2, std::string(4, 'b')));
+        assert(cache.bytes() == 8);
+
+        assert(cache.put(3, std::string(4, 'c')));
+        assert(cache.size() == 2);
+        assert(cache.bytes() == 8);
+        assert(!cache.contains(1));
+
+        assert(!cache.put(4, std::string(11, 'd')));
+        assert(!cache.contains(4));
+        assert(cache.size() == 2);
+
+        assert(cache.put(2, std::string(9, 'b')));
+        assert(cache.size() == 1);
+        assert(cache.bytes() == 9);
+        assert(*cache.peek(2) == std::string(9, 'b'));
+    }
+
+    void clock_evicts_by_count()
+    {
+        bice::ClockCache<int, int> cache(64, std::numeric_limits<std::uint64_t>::max(), 4);
+        for(int key = 0; key < 1000; ++key)
+        {
+            assert(cache.put(key, key));
+        }
+        assert(cache.size() <= 64);
+        assert(cache.size() > 0);
+
+        std::uint64_t found{0};
+        for(int key = 0; key < 1000; ++key)
+        {
+            const auto value = cache.get(key);
+            if (value.has_value())
+            {
+                assert(*value == key);
+                ++found;
+            }
+        }
+        assert(found == cache.size());
+    }
+
+    void clock_evicts_by_bytes()
+    {
+        bice::ClockCache<int, std::string, std::hash<int>, std::equal_to<int>, LengthWeight> cache(1000, 400, 4);
+        for(int key = 0; key < 1000; ++key)
+        {
+            cache.put(key, std::string(10, 'x'));
+        }
+        assert(cache.bytes() <= 400);
+        assert(cache.size() <= 40);
+        assert(cache.size() > 0);
+        assert(!cache.put(-1, std::string(401, 'y')));
+    }
+
+    void clock_concurrent_access()
+    {
+        bice::ClockCache<int, int> cache(256, std::numeric_limits<std::uint64_t>::max(), 8);
+        std::vector<std::thread> threads;
+        for(int thread = 0; thread < 4; ++thread)
+        {
+            threads.emplace_back([&cache, thread]()
+            {
+                for(int step = 0; step < 20000; ++step)
+                {
+                    const int key = (step * 7 + thread) % 1024;
+                    if (step % 3 == 0)
+                    {
+                        cache.put(key, key);
+                    } else if (step % 11 == 0)
+                    {
+                        cache.erase(key);
+                    } else
+                    {
+                        const auto value = cache.get(key);
+                        assert(!value.has_value() || *value == key);
+                    }
+                }
+            });
+        }
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+        assert(cache.size() <= 256);
+    }
+
+}
+
+int main()
+{
+    lru_evicts_by_count();
+    lru_evicts_by_bytes();
+    clock_evicts_by_count();
+    clock_evicts_by_bytes();
+    clock_concurrent_access();
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+#include "../Collections/red_black_tree.h"
+
+namespace
+{
+
+    struct Key
+    {
+        int value;
+    };
+
+    struct KeyLess
+    {
+        bool operator () (const Key& left, const Key& right) const noexcept
+        {
+            return left.value < right.value;
+        }
+    };
+
+    template<typename TYPE>
+    struct CountingAllocator
+    {
+        using value_type = TYPE;
+
+        std::int64_t* live;
+
+        explicit CountingAllocator(std::int64_t* live_) noexcept : live(live_) {}
+
+        template<typename OTHER>
+        CountingAllocator(const CountingAllocator<OTHER>& other) noexcept : live(other.live) {}
+
+        TYPE* allocate(const std::size_t count)
+        {
+            ++*live;
+            return std::allocator<TYPE>().allocate(count);
+        }
+
+        void deallocate(TYPE* pointer, const std::size_t count) noexcept
+        {
+            --*live;
+            std::allocator<TYPE>().deallocate(pointer, count);
+        }
+
+        template<typename OTHER>
+        bool operator == (const CountingAllocator<OTHER>& other) const noexcept
+        {
+            return live == other.live;
+        }
+    };
+
+    template<typename TREE>
+    typename TREE::node_pointer root_of(TREE& tree)
+    {
+        typename TREE::node_pointer node = tree.begin().node;
+        while (node->parent != nullptr)
+        {
+            node = node->parent;
+        }
+        return node;
+    }
+
+    template<typename NODE>
+    int check_subtree(NODE* node, NODE* endNode, std::uint64_t& count)
+    {
+        if (node == nullptr || node == endNode)
+        {
+            count = 0;
+            return 1;
+        }
+
+        if (node->color == bice::RBTColor::RED)
+        {
+            assert(node->left == nullptr || node->left->color == bice::RBTColor::BLACK);
+            assert(node->right == nullptr || node->right == endNode || node->right->color == bice::RBTColor::BLACK);
+        }
+        assert(node->left == nullptr || node->left->parent == node);
+        assert(node->right == nullptr || node->right->parent == node);
+
+        std::uint64_t leftCount{0};
+        std::uint64_t rightCount{0};
+        const int leftHeight = check_subtree(node->left, endNode, leftCount);
+        const int rightHeight = check_subtree(node->right, endNode, rightCount);
+        assert(leftHeight == rightHeight);
+        count = leftCount + rightCount + 1;
+        if constexpr (requires { node->size; })
+        {
+            assert(node->size == count);
+        }
+        return leftHeight + (node->color == bice::RBTColor::BLACK ? 1 : 0);
+    }
+
+    template<typename TREE>
+    void check_invariants(TREE& tree)
+    {
+        if (tree.empty())
+        {
+            assert(tree.begin() == tree.end());
+            return;
+        }
+
+        auto root = root_of(tree);
+        assert(root->color == bice::RBTColor::BLACK);
+        std::uint64_t count{0};
+        check_subtree(root, tree.end().node, count);
+        assert(count == tree.size());
+    }
+
+    void duplicate_input()
+    {
+        bice::RedBlackTree<int> list{1, 1, 2};
+        assert(list.size() == 2);
+        assert(list.contains(1) && list.contains(2));
+
+        const std::vector<int> values{3, 1, 3, 2, 1};
+        bice::RedBlackTree<int> range(values.begin(), values.end());
+        assert(range.size() == 3);
+    }
+
+    void comparator_only_type()
+    {
+        bice::RedBlackTree<Key, KeyLess> tree;
+        for(int value = 0; value < 20; ++value)
+        {
+            tree.insert(Key{value * 2});
+        }
+
+        int expected{0};
+        for(auto iter = tree.begin(); iter != tree.end(); ++iter)
+        {
+            assert(iter->value == expected);
+            expected += 2;
+        }
+
+        int visited{0};
+        for(const Key& key : tree.range(Key{5}, Key{15}))
+        {
+            assert(key.value >= 5 && key.value < 15);
+            ++visited;
+        }
+        assert(visited == 5);
+    }
+
+    void bounds_and_ranges()
+    {
+        bice::RedBlackTree<int> tree{10, 20, 30, 40};
+        assert(*tree.lower_bound(20) == 20);
+        assert(*tree.lower_bound(21) == 30);
+        assert(*tree.upper_bound(20) == 30);
+        assert(tree.lower_bound(41) == tree.end());
+
+        auto [first, last] = tree.equal_range(30);
+        assert(*first == 30 && *last == 40);
+
+        std::vector<int> values;
+        for(const int value : tree.range(15, 40))
+        {
+            values.push_back(value);
+        }
+        assert((values == std::vector<int>{20, 30}));
+    }
+
+    void insert_remove_stress()
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> keys(0, 511);
+        bice::RedBlackTree<int, std::less<int>, std::allocator<int>, true> tree;
+        std::set<int> reference;
+
+        for(int step = 0; step < 20000; ++step)
+        {
+            const int key = keys(generator);
+            if (generator() % 2 == 0)
+            {
+                tree.insert(key);
+                reference.insert(key);
+            } else
+            {
+                tree.remove(key);
+                reference.erase(key);
+            }
+
+            assert(tree.size() == reference.size());
+            if (step % 64 == 0)
+            {
+                check_invariants(tree);
+                std::uint64_t index{0};
+                for(const int value : reference)
+                {
+                    assert(*tree.nth_element(index) == value);
+                    assert(tree.rank(value) == index);
+                    ++index;
+                }
+            }
+        }
+
+        while (!reference.empty())
+        {
+            tree.remove(tree.begin());
+            reference.erase(reference.begin());
+            assert(tree.size() == reference.size());
+        }
+        check_invariants(tree);
+    }
+
+    void from_sorted_shapes()
+    {
+        using tree_type = bice::RedBlackTree<int, std::less<int>, std::allocator<int>, true>;
+        for(int count = 1; count <= 257; ++count)
+        {
+            std::vector<int> values(count);
+            for(int idx = 0; idx < count; ++idx)
+            {
+                values[idx] = idx;
+            }
+
+            tree_type tree = tree_type::from_sorted(values.begin(), values.end());
+            assert(tree.size() == (std::uint64_t)count);
+            check_invariants(tree);
+            assert(*tree.nth_element(count / 2) == count / 2);
+        }
+    }
+
+    void stateful_allocator()
+    {
+        using allocator_type = CountingAllocator<int>;
+        using tree_type = bice::RedBlackTree<int, std::less<int>, allocator_type>;
+        std::int64_t leftLive{0};
+        std::int64_t rightLive{0};
+        const std::vector<int> values{1, 2, 3, 4, 5, 6, 7, 8};
+        {
+            tree_type left = tree_type::from_sorted(values.begin(), values.end(), std::less<int>(), allocator_type(&leftLive));
+            tree_type right{allocator_type(&rightLive)};
+            right.insert(10);
+            left.swap(right);
+            assert(left.size() == 1 && right.size() == 8);
+
+            tree_type moved(std::move(right));
+            tree_type assigned{allocator_type(&rightLive)};
+            assigned = std::move(moved);
+            assert(assigned.size() == 8);
+
+            tree_type copied(assigned);
+            assert(copied.size() == 8);
+            check_invariants(copied);
+        }
+        assert(leftLive == 0);
+        assert(rightLive == 0);
+    }
+
+}
+
+int main()
+{
+    duplicate_input();
+    comparator_only_type();
+    bounds_and_ranges();
+    insert_remove_stress();
+    from_sorted_shapes();
+    stateful_allocator();
+    return 0;
+}